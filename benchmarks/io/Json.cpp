@@ -0,0 +1,719 @@
+#include <jjyou/io/Json.hpp>
+#include <jjyou/io/NdjsonReader.hpp>
+#include <jjyou/io/JsonPath.hpp>
+#include <jjyou/io/JsonPushParser.hpp>
+#include <jjyou/io/JsonBind.hpp>
+#include <jjyou/io/JsonWriter.hpp>
+#include <jjyou/io/Base64.hpp>
+#include <jjyou/utils.hpp>
+#include <memory_resource>
+#include <functional>
+using Json = jjyou::io::Json<long long, double, std::string, bool>;
+using PmrJson = jjyou::io::Json<long long, double, std::pmr::string, bool>;
+using FlatJson = jjyou::io::Json<long long, double, std::string, bool, jjyou::io::JsonFlatObject>;
+using OrderedJson = jjyou::io::Json<long long, double, std::string, bool, jjyou::io::JsonOrderedObject>;
+using InSituJson = jjyou::io::Json<long long, double, std::string_view, bool>;
+using JsonView = jjyou::io::JsonView<long long, double, std::string, bool>;
+using JsonPath = jjyou::io::JsonPath<long long, double, std::string, bool>;
+using JsonPushParser = jjyou::io::JsonPushParser<long long, double, std::string, bool>;
+using HashedJson = jjyou::io::HashedJson<long long, double, std::string, bool>;
+
+// Results of the measured loops are stored here so that they are not optimized away.
+volatile long long benchmarkSink = 0;
+
+// One small record, similar to a per-frame log entry.
+std::string makeRecord(std::size_t i) {
+	std::string res = "{\"id\": " + std::to_string(i) + ", \"name\": \"object_name_" + std::to_string(i) + "\", ";
+	res += "\"tags\": [\"alpha\", \"beta\", \"gamma\"], \"pose\": [0.25, -1.5, 3.125, 0.0, 0.5, 0.5, 0.70710678], ";
+	res += "\"valid\": " + std::string(i % 2 ? "true" : "false") + ", \"meta\": {\"frame\": " + std::to_string(3 * i) + ", \"note\": null}}";
+	return res;
+}
+
+// Array of `count` records.
+std::string makeRecords(std::size_t count) {
+	std::string res = "[\n";
+	for (std::size_t i = 0; i < count; ++i) {
+		res += "\t" + makeRecord(i);
+		res += (i + 1 == count) ? "\n" : ",\n";
+	}
+	res += "]\n";
+	return res;
+}
+
+// `count` records, one per line.
+std::string makeRecordLines(std::size_t count) {
+	std::string res;
+	for (std::size_t i = 0; i < count; ++i)
+		res += makeRecord(i) + "\n";
+	return res;
+}
+
+// Run `func` `repeat` times and report the best throughput.
+void report(const std::string& name, std::size_t bytes, int repeat, const std::function<void(void)>& func) {
+	jjyou::utils::Clock clock;
+	double best = 0.0;
+	for (int i = 0; i < repeat; ++i) {
+		clock.begin();
+		func();
+		double seconds = clock.end();
+		if (i == 0 || seconds < best) best = seconds;
+	}
+	std::cout << name << "\t" << best * 1000.0 << " ms\t" << static_cast<double>(bytes) / best / 1e6 << " MB/s" << std::endl;
+}
+
+void benchmarkAllocator(void) {
+	const std::string src = makeRecords(200000);
+	report("parse+destroy (std::allocator)", src.size(), 5, [&]() {
+		Json json = Json::parse(src);
+	});
+	report("parse+destroy (pmr arena)", src.size(), 5, [&]() {
+		std::pmr::monotonic_buffer_resource arena(src.size() * 4);
+		PmrJson json = PmrJson::parse(src, &arena);
+	});
+}
+
+void benchmarkInSitu(void) {
+	const std::string src = makeRecords(200000);
+	report("parse+destroy (std::string)", src.size(), 5, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src).size());
+	});
+	report("parse+destroy (std::string_view, in situ)", src.size(), 5, [&]() {
+		jjyou::io::JsonStringArena<char> arena;
+		benchmarkSink = static_cast<long long>(InSituJson::parse(src, arena).size());
+	});
+}
+
+// One object with `count` members, e.g. a lookup table keyed by name.
+std::string makeTable(std::size_t count) {
+	std::string res = "{\n";
+	for (std::size_t i = 0; i < count; ++i) {
+		res += "\t\"entry_" + std::to_string((i * 7919) % count) + "\": " + std::to_string(i);
+		res += (i + 1 == count) ? "\n" : ",\n";
+	}
+	res += "}\n";
+	return res;
+}
+
+template <class JsonTy>
+void benchmarkObject(const std::string& name, const std::string& records, const std::string& table) {
+	JsonTy recordsJson = JsonTy::parse(records);
+	JsonTy tableJson = JsonTy::parse(table);
+	const std::vector<std::string> recordKeys = { "id", "name", "tags", "pose", "valid", "meta" };
+	std::vector<std::string> tableKeys;
+	for (std::size_t i = 0; i < tableJson.size(); ++i)
+		tableKeys.push_back("entry_" + std::to_string(i));
+	long long sink = 0;
+	report(name + " parse", records.size(), 5, [&]() {
+		JsonTy json = JsonTy::parse(records);
+		sink += static_cast<long long>(json.size());
+	});
+	report(name + " lookup (small objects)", records.size(), 5, [&]() {
+		for (const JsonTy& record : recordsJson)
+			for (const std::string& key : recordKeys)
+				sink += static_cast<long long>(record.find(key)->size());
+	});
+	report(name + " lookup (large object)", table.size(), 5, [&]() {
+		for (const std::string& key : tableKeys)
+			sink += static_cast<long long>(tableJson.at(key));
+	});
+	report(name + " iteration", records.size(), 5, [&]() {
+		for (const JsonTy& record : recordsJson)
+			for (auto iter = record.begin(); iter != record.end(); ++iter)
+				sink += static_cast<long long>(iter.key().size());
+	});
+	benchmarkSink = sink;
+}
+
+void benchmarkObjectStorage(void) {
+	const std::string records = makeRecords(200000);
+	const std::string table = makeTable(100000);
+	benchmarkObject<Json>("std::map", records, table);
+	benchmarkObject<FlatJson>("flat", records, table);
+	benchmarkObject<OrderedJson>("ordered hash", records, table);
+}
+
+void benchmarkBinary(void) {
+	const std::string src = makeRecords(200000);
+	const Json json = Json::parse(src);
+	const std::vector<std::uint8_t> cbor = json.toCBOR();
+	const std::vector<std::uint8_t> msgPack = json.toMsgPack();
+	std::cout << "text " << src.size() << " bytes, CBOR " << cbor.size() << " bytes, MessagePack " << msgPack.size() << " bytes" << std::endl;
+	report("parse (text)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src).size());
+	});
+	report("fromCBOR", cbor.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::fromCBOR(cbor).size());
+	});
+	report("fromMsgPack", msgPack.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::fromMsgPack(msgPack).size());
+	});
+	report("fromCBOR (std::string_view, in situ)", cbor.size(), 3, [&]() {
+		jjyou::io::JsonStringArena<char> arena;
+		benchmarkSink = static_cast<long long>(InSituJson::fromCBOR(cbor, arena).size());
+	});
+	report("dump compact (text)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(json.dump(Json::DumpOptions{ false }).size());
+	});
+	report("toCBOR", cbor.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(json.toCBOR().size());
+	});
+	report("toMsgPack", msgPack.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(json.toMsgPack().size());
+	});
+}
+
+void benchmarkPath(void) {
+	const std::string src = makeRecords(200000);
+	const Json json = Json::parse(src);
+	long long sink = 0;
+	report("chained operator[] (3 fields)", src.size(), 5, [&]() {
+		for (std::size_t i = 0; i < json.size(); ++i) {
+			const Json& record = json[i];
+			sink += static_cast<long long>(record["id"]);
+			sink += static_cast<long long>(record["meta"]["frame"]);
+			sink += static_cast<long long>(static_cast<double>(record["pose"][2]));
+		}
+	});
+	const JsonPath path{ "/*/id", "/*/meta/frame", "/*/pose/2" };
+	report("JsonPath::evaluate (3 fields)", src.size(), 5, [&]() {
+		path.evaluate(json, [&](std::size_t index, const Json& value) {
+			sink += (index == 2) ? static_cast<long long>(static_cast<double>(value)) : static_cast<long long>(value);
+		});
+	});
+	const JsonView view(src);
+	report("chained operator[] (3 fields, JsonView)", src.size(), 3, [&]() {
+		for (const JsonView& record : view) {
+			sink += static_cast<long long>(record["id"]);
+			sink += static_cast<long long>(record["meta"]["frame"]);
+			sink += static_cast<long long>(static_cast<double>(record["pose"][2]));
+		}
+	});
+	report("JsonPath::evaluate (3 fields, JsonView)", src.size(), 3, [&]() {
+		path.evaluate(view, [&](std::size_t index, const JsonView& value) {
+			sink += (index == 2) ? static_cast<long long>(static_cast<double>(value)) : static_cast<long long>(value);
+		});
+	});
+	benchmarkSink = sink;
+}
+
+void benchmarkParallel(void) {
+	const std::string src = makeRecords(200000);
+	const Json expected = Json::parse(src);
+	const std::size_t maxThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+		Json::ParseOptions options;
+		options.threads = threads;
+		Json json;
+		report("parse (records), " + std::to_string(threads) + " thread(s)", src.size(), 3, [&]() {
+			json = Json::parse(src, options);
+		});
+		if (json != expected)
+			std::cout << "parallel parse differs from sequential parse" << std::endl;
+	}
+}
+
+void benchmarkPush(void) {
+	const std::string src = makeRecords(200000);
+	const Json expected = Json::parse(src);
+	report("parse (whole buffer)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src).size());
+	});
+	for (std::size_t chunkSize : { std::size_t(1) << 10, std::size_t(1) << 16 }) {
+		Json json;
+		report("JsonPushParser::feedValues, " + std::to_string(chunkSize) + "-byte chunks", src.size(), 3, [&]() {
+			JsonPushParser parser;
+			for (std::size_t i = 0; i < src.size(); i += chunkSize)
+				parser.feedValues(std::string_view(src).substr(i, chunkSize), [&](Json&& value) { json = std::move(value); });
+			parser.finishValues([&](Json&& value) { json = std::move(value); });
+		});
+		if (json != expected)
+			std::cout << "push parse differs from Json::parse" << std::endl;
+	}
+}
+
+void benchmarkHash(void) {
+	// Two snapshots of a large document that differ in one record.
+	const std::string src = makeRecords(200000);
+	const Json snapshot1 = Json::parse(src);
+	Json snapshot2 = snapshot1;
+	snapshot2[123456]["meta"]["frame"] = 0LL;
+	long long sink = 0;
+	report("operator== (different)", src.size(), 3, [&]() {
+		sink += (snapshot1 == snapshot2);
+	});
+	report("hash", src.size(), 3, [&]() {
+		sink += static_cast<long long>(snapshot1.hash() ^ snapshot2.hash());
+	});
+	report("diff", src.size(), 3, [&]() {
+		sink += static_cast<long long>(Json::diff(snapshot1, snapshot2).size());
+	});
+	const HashedJson hashed1(snapshot1), hashed2(snapshot2);
+	report("operator== (different, HashedJson)", src.size(), 3, [&]() {
+		sink += (hashed1 == hashed2);
+	});
+	std::cout << "diff: " << Json::diff(snapshot1, snapshot2).dump(Json::DumpOptions{ false }) << std::endl;
+	benchmarkSink = sink;
+}
+
+void benchmarkNdjson(void) {
+	const std::string src = makeRecordLines(200000);
+	long long sink = 0;
+	report("line-by-line Json::parse", src.size(), 3, [&]() {
+		std::istringstream sstream(src);
+		std::string line;
+		while (std::getline(sstream, line))
+			sink += static_cast<long long>(Json::parse(line).size());
+	});
+	const std::size_t maxThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+		jjyou::io::NdjsonReader<Json>::Options options;
+		options.threads = threads;
+		jjyou::io::NdjsonReader<Json> reader(std::string_view(src), options);
+		report("NdjsonReader::read, " + std::to_string(threads) + " thread(s)", src.size(), 3, [&]() {
+			reader.read([&](jjyou::io::NdjsonReader<Json>::Record&& record) { sink += static_cast<long long>(record.json.size()); });
+		});
+		std::atomic<long long> count = 0;
+		report("NdjsonReader::readUnordered, " + std::to_string(threads) + " thread(s)", src.size(), 3, [&]() {
+			reader.readUnordered([&](jjyou::io::NdjsonReader<Json>::Record&& record) { count += static_cast<long long>(record.json.size()); });
+		});
+		sink += count;
+	}
+	benchmarkSink = sink;
+}
+
+void benchmarkDump(void) {
+	// Large numeric array, e.g. a point cloud.
+	Json points(jjyou::io::JsonType::Array);
+	for (std::size_t i = 0; i < 3000000; ++i)
+		points.array().push_back(static_cast<double>(i % 1000) * 0.001 - static_cast<double>(i) / 7.0);
+	const Json records = Json::parse(makeRecords(100000));
+	std::size_t bytes = points.dump().size();
+	report("to_string (numeric array)", bytes, 3, [&]() {
+		benchmarkSink = static_cast<long long>(jjyou::io::to_string(points).size());
+	});
+	bytes = points.dump(Json::DumpOptions{ false }).size();
+	report("dump compact (numeric array)", bytes, 3, [&]() {
+		benchmarkSink = static_cast<long long>(points.dump(Json::DumpOptions{ false }).size());
+	});
+	bytes = records.dump().size();
+	report("to_string (records)", bytes, 3, [&]() {
+		benchmarkSink = static_cast<long long>(jjyou::io::to_string(records).size());
+	});
+}
+
+// Per-frame state of `count` objects, written as a Json container or with `JsonWriter`.
+// Keys are in the order of `std::map`, so that both give the same output.
+void benchmarkWriter(void) {
+	const std::size_t count = 200000;
+	const double pose[7] = { 0.25, -1.5, 3.125, 0.0, 0.5, 0.5, 0.70710678 };
+	auto build = [&](void) -> Json {
+		Json res(jjyou::io::JsonType::Array);
+		for (std::size_t i = 0; i < count; ++i) {
+			Json record(jjyou::io::JsonType::Object);
+			record["id"] = static_cast<long long>(i);
+			record["meta"] = Json(jjyou::io::JsonType::Object);
+			record["meta"]["frame"] = static_cast<long long>(3 * i);
+			record["meta"]["note"] = Json();
+			record["name"] = "object_name_" + std::to_string(i);
+			record["pose"] = Json(jjyou::io::JsonType::Array);
+			for (double v : pose)
+				record["pose"].array().push_back(v);
+			record["tags"] = Json{ "alpha", "beta", "gamma" };
+			record["valid"] = static_cast<bool>(i % 2);
+			res.array().push_back(std::move(record));
+		}
+		return res;
+	};
+	auto write = [&](auto& writer) -> void {
+		writer.beginArray();
+		for (std::size_t i = 0; i < count; ++i) {
+			writer.beginObject();
+			writer.key("id"); writer.value(static_cast<long long>(i));
+			writer.key("meta"); writer.beginObject();
+			writer.key("frame"); writer.value(static_cast<long long>(3 * i));
+			writer.key("note"); writer.value(nullptr);
+			writer.endObject();
+			writer.key("name"); writer.value("object_name_" + std::to_string(i));
+			writer.key("pose"); writer.beginArray();
+			for (double v : pose)
+				writer.value(v);
+			writer.endArray();
+			writer.key("tags"); writer.beginArray(); writer.value("alpha"); writer.value("beta"); writer.value("gamma"); writer.endArray();
+			writer.key("valid"); writer.value(static_cast<bool>(i % 2));
+			writer.endObject();
+		}
+		writer.endArray();
+	};
+	for (bool pretty : { true, false }) {
+		const jjyou::io::JsonDumpOptions options{ pretty };
+		const std::string expected = build().dump(options);
+		const std::string name = pretty ? " (records)" : " (records, compact)";
+		report("build Json + dump" + name, expected.size(), 3, [&]() {
+			benchmarkSink = static_cast<long long>(build().dump(options).size());
+		});
+		report("JsonWriter, string sink" + name, expected.size(), 3, [&]() {
+			std::string out;
+			jjyou::io::JsonWriter writer{ jjyou::io::JsonStringSink(out), options };
+			write(writer);
+			writer.flush();
+			benchmarkSink = static_cast<long long>(out.size());
+		});
+		// Constant memory: the output is only counted, e.g. instead of sent to a socket.
+		report("JsonWriter, callback sink" + name, expected.size(), 3, [&]() {
+			std::size_t size = 0;
+			auto sink = [&size](const char*, std::size_t length) -> void { size += length; };
+			jjyou::io::JsonWriter<char, decltype(sink)&> writer(sink, options);
+			write(writer);
+			writer.flush();
+			benchmarkSink = static_cast<long long>(size);
+		});
+		std::string out;
+		{
+			jjyou::io::JsonWriter writer{ jjyou::io::JsonStringSink(out), options };
+			write(writer);
+		}
+		std::cout << "same output as Json::dump: " << (out == expected) << std::endl;
+	}
+}
+
+void benchmarkNumbers(void) {
+	// Numeric array with full-precision doubles, e.g. a point cloud written by `dump`.
+	Json points(jjyou::io::JsonType::Array);
+	for (std::size_t i = 0; i < 2000000; ++i)
+		points.array().push_back(static_cast<double>(i % 1000) * 0.001 - static_cast<double>(i) / 7.0);
+	const std::string src = points.dump(Json::DumpOptions{ false });
+	report("parse (numeric array)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src).size());
+	});
+	Json::ParseOptions lazyNumbers;
+	lazyNumbers.lazyNumbers = true;
+	report("parse (numeric array, lazy numbers)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src, lazyNumbers).size());
+	});
+	report("parse+dump (numeric array)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src).dump(Json::DumpOptions{ false }).size());
+	});
+	report("parse+dump (numeric array, lazy numbers)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src, lazyNumbers).dump(Json::DumpOptions{ false }).size());
+	});
+	// Values must survive a dump/parse round trip exactly.
+	const Json parsed = Json::parse(src);
+	std::size_t mismatches = 0;
+	for (std::size_t i = 0; i < points.size(); ++i)
+		mismatches += (static_cast<double>(parsed[i]) != static_cast<double>(points[i]));
+	const Json lazy = Json::parse(src, lazyNumbers);
+	for (std::size_t i = 0; i < points.size(); ++i)
+		mismatches += (static_cast<double>(lazy[i]) != static_cast<double>(points[i]));
+	std::cout << "round-trip mismatches: " << mismatches << std::endl;
+}
+
+void benchmarkMove(void) {
+	// Long strings, e.g. file paths, which do not fit in the small string buffer.
+	Json names(jjyou::io::JsonType::Array);
+	for (std::size_t i = 0; i < 1000000; ++i)
+		names.array().push_back("/data/scenes/scene_0000/frames/frame_" + std::to_string(i) + ".png");
+	const std::size_t bytes = names.dump(Json::DumpOptions{ false }).size();
+	long long sink = 0;
+	report("operator std::vector<std::string>() const&", bytes, 3, [&]() {
+		Json copy = names;
+		sink += static_cast<long long>(static_cast<std::vector<std::string>>(copy).size());
+	});
+	report("operator std::vector<std::string>() &&", bytes, 3, [&]() {
+		Json copy = names;
+		sink += static_cast<long long>(static_cast<std::vector<std::string>>(std::move(copy)).size());
+	});
+	Json document(jjyou::io::JsonType::Object);
+	document["names"] = names;
+	report("copy a subtree out of a document", bytes, 3, [&]() {
+		Json copy = document;
+		Json subtree = copy["names"];
+		sink += static_cast<long long>(subtree.size());
+	});
+	report("Json::extract", bytes, 3, [&]() {
+		Json copy = document;
+		Json subtree = copy.extract("names");
+		sink += static_cast<long long>(subtree.size());
+	});
+	benchmarkSink = sink;
+}
+
+// A triangle mesh with `count` vertices, as written by a mesh exporter.
+std::string makeMesh(std::size_t count) {
+	Json mesh(jjyou::io::JsonType::Object);
+	Json& positions = mesh["positions"] = Json(jjyou::io::JsonType::Array);
+	Json& normals = mesh["normals"] = Json(jjyou::io::JsonType::Array);
+	Json& indices = mesh["indices"] = Json(jjyou::io::JsonType::Array);
+	for (std::size_t i = 0; i < count; ++i) {
+		for (int k = 0; k < 3; ++k) {
+			positions.array().push_back(static_cast<double>((i * 7 + k * 13) % 1000) * 0.01 + 0.5);
+			normals.array().push_back(static_cast<double>(k) * 0.25 + 0.125);
+			indices.array().push_back(static_cast<long long>((i + k) % count));
+		}
+	}
+	return mesh.dump(Json::DumpOptions{ false });
+}
+
+// Memory resource that counts the bytes in use, to measure the size of a document.
+class CountingResource : public std::pmr::memory_resource {
+public:
+	std::size_t bytes = 0;
+private:
+	void* do_allocate(std::size_t size, std::size_t alignment) override {
+		this->bytes += size;
+		return std::pmr::new_delete_resource()->allocate(size, alignment);
+	}
+	void do_deallocate(void* p, std::size_t size, std::size_t alignment) override {
+		this->bytes -= size;
+		std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+
+void benchmarkPacked(void) {
+	const std::string src = makeMesh(1000000);
+	Json::ParseOptions packed;
+	packed.packNumbers = true;
+	Json::ParseOptions packedKeys;
+	packedKeys.packedKeys = { "positions", "normals" };
+	report("Json::parse (mesh)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src).size());
+	});
+	report("Json::parse (mesh, packed numbers)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src, packed).size());
+	});
+	report("Json::parse (mesh, packed keys)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(Json::parse(src, packedKeys).size());
+	});
+	for (bool packNumbers : { false, true }) {
+		CountingResource resource;
+		PmrJson::ParseOptions options;
+		options.packNumbers = packNumbers;
+		PmrJson json = PmrJson::parse(src, options, &resource);
+		std::cout << "memory of the mesh" << (packNumbers ? " (packed numbers)" : "") << "\t" << static_cast<double>(resource.bytes) / 1e6 << " MB" << std::endl;
+	}
+	Json regular = Json::parse(src);
+	Json packedMesh = Json::parse(src, packed);
+	report("operator std::vector<double>() const& (positions)", src.size() / 3, 3, [&]() {
+		benchmarkSink = static_cast<long long>(static_cast<std::vector<double>>(regular["positions"]).size());
+	});
+	report("operator std::vector<double>() const& (positions, packed)", src.size() / 3, 3, [&]() {
+		benchmarkSink = static_cast<long long>(static_cast<std::vector<double>>(packedMesh["positions"]).size());
+	});
+	report("Json::floatings (positions, packed)", src.size() / 3, 3, [&]() {
+		std::span<const double> positions = std::as_const(packedMesh)["positions"].floatings();
+		benchmarkSink = static_cast<long long>(positions.size());
+	});
+	report("dump compact (mesh)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(regular.dump(Json::DumpOptions{ false }).size());
+	});
+	report("dump compact (mesh, packed)", src.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(packedMesh.dump(Json::DumpOptions{ false }).size());
+	});
+	std::cout << "packed mesh equal: " << (regular == packedMesh) << ", same dump: " << (regular.dump(Json::DumpOptions{ false }) == packedMesh.dump(Json::DumpOptions{ false })) << std::endl;
+}
+
+// A scene graph `depth` levels deep: each node has a transform and one child.
+std::string makeSceneGraph(std::size_t depth) {
+	std::string res;
+	for (std::size_t i = 0; i < depth; ++i)
+		res += "{\"name\": \"node_" + std::to_string(i) + "\", \"transform\": [1, 0, 0, 0, 1, 0, 0, 0, 1], \"children\": [";
+	res += "null";
+	for (std::size_t i = 0; i < depth; ++i)
+		res += "]}";
+	return res;
+}
+
+void benchmarkNesting(void) {
+	Json::ParseOptions options;
+	options.maxDepth = std::numeric_limits<std::size_t>::max();
+	const std::string records = makeRecords(200000);
+	// Deeper than the call stack of a worker thread allows for recursive functions.
+	const std::string scene = makeSceneGraph(200000);
+	long long sink = 0;
+	for (const std::string* src : { &records, &scene }) {
+		const std::string name = (src == &records) ? " (records)" : " (deep scene graph)";
+		const Json json = Json::parse(*src, options);
+		const Json copy = Json::parse(*src, options);
+		report("Json::parse" + name, src->size(), 3, [&]() {
+			sink += static_cast<long long>(Json::parse(*src, options).size());
+		});
+		report("dump compact" + name, src->size(), 3, [&]() {
+			sink += static_cast<long long>(json.dump(Json::DumpOptions{ false }).size());
+		});
+		report("operator==" + name, src->size(), 3, [&]() {
+			sink += static_cast<long long>(json == copy);
+		});
+		std::vector<Json> trees;
+		for (int i = 0; i < 3; ++i)
+			trees.push_back(Json::parse(*src, options));
+		report("destroy" + name, src->size(), 3, [&]() {
+			trees.back().reset();
+			trees.pop_back();
+		});
+	}
+	benchmarkSink = sink;
+}
+
+// The struct of `makeRecord`.
+struct RecordMeta {
+	long long frame = 0;
+	std::optional<std::string> note;
+};
+JJYOU_JSON_DESCRIBE(RecordMeta, frame, note)
+struct Record {
+	long long id = 0;
+	std::string name;
+	std::vector<std::string> tags;
+	std::array<double, 7> pose{};
+	bool valid = false;
+	RecordMeta meta;
+};
+JJYOU_JSON_DESCRIBE(Record, id, name, tags, pose, valid, meta)
+
+void benchmarkBind(void) {
+	const std::string src = makeRecords(200000);
+	std::vector<Record> records;
+	report("Json::parse + conversion", src.size(), 3, [&]() {
+		const Json json = Json::parse(src);
+		records.clear();
+		for (const Json& element : json) {
+			Record& record = records.emplace_back();
+			record.id = static_cast<long long>(element["id"]);
+			record.name = static_cast<std::string>(element["name"]);
+			record.tags = static_cast<std::vector<std::string>>(element["tags"]);
+			for (std::size_t i = 0; i < record.pose.size(); ++i)
+				record.pose[i] = static_cast<double>(element["pose"][i]);
+			record.valid = static_cast<bool>(element["valid"]);
+			record.meta.frame = static_cast<long long>(element["meta"]["frame"]);
+			if (element["meta"]["note"].type() != jjyou::io::JsonType::Null)
+				record.meta.note = static_cast<std::string>(element["meta"]["note"]);
+		}
+	});
+	std::vector<Record> bound;
+	report("parseInto", src.size(), 3, [&]() {
+		bound = jjyou::io::parseInto<std::vector<Record>>(src);
+	});
+	std::string dumped;
+	report("conversion + Json::dump", src.size(), 3, [&]() {
+		Json json(jjyou::io::JsonType::Array);
+		for (const Record& record : bound) {
+			Json element(jjyou::io::JsonType::Object);
+			element["id"] = record.id;
+			element["name"] = record.name;
+			Json tags(jjyou::io::JsonType::Array);
+			for (const std::string& tag : record.tags)
+				tags.array().push_back(tag);
+			element["tags"] = std::move(tags);
+			Json pose(jjyou::io::JsonType::Array);
+			for (double value : record.pose)
+				pose.array().push_back(value);
+			element["pose"] = std::move(pose);
+			element["valid"] = record.valid;
+			Json meta(jjyou::io::JsonType::Object);
+			meta["frame"] = record.meta.frame;
+			meta["note"] = record.meta.note ? Json(*record.meta.note) : Json();
+			element["meta"] = std::move(meta);
+			json.array().push_back(std::move(element));
+		}
+		dumped = json.dump(Json::DumpOptions{ false });
+	});
+	std::string bindDumped;
+	report("dumpFrom", src.size(), 3, [&]() {
+		bindDumped = jjyou::io::dumpFrom(bound, jjyou::io::JsonDumpOptions{ false });
+	});
+	if (Json::parse(dumped) != Json::parse(bindDumped) || Json::parse(bindDumped) != Json::parse(src))
+		std::cout << "bound records differ from Json::parse" << std::endl;
+}
+
+void benchmarkBase64(void) {
+	// A glTF buffer embedded as a data URI.
+	std::vector<std::uint8_t> blob(64 << 20);
+	for (std::size_t i = 0; i < blob.size(); ++i)
+		blob[i] = static_cast<std::uint8_t>((i * 2654435761u) >> 13);
+	Json gltf(jjyou::io::JsonType::Object);
+	gltf["uri"] = "data:application/octet-stream;base64," + jjyou::io::Base64<>::encode(blob);
+	const std::string_view text = *jjyou::io::Base64<>::dataUriPayload(gltf["uri"].string());
+	std::vector<std::uint8_t> decoded(jjyou::io::Base64<>::decodedSize(text));
+	report("encode", blob.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(jjyou::io::Base64<>::encode(blob).size());
+	});
+	// The usual hand-written decoder: one character at a time with `std::string::find`.
+	report("decode, per character", text.size(), 3, [&]() {
+		static const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		std::vector<std::uint8_t> out;
+		out.reserve(decoded.size());
+		std::uint32_t group = 0;
+		int bits = 0;
+		for (char c : text) {
+			if (c == '=')
+				break;
+			group = (group << 6) | static_cast<std::uint32_t>(alphabet.find(c));
+			bits += 6;
+			if (bits >= 8) {
+				bits -= 8;
+				out.push_back(static_cast<std::uint8_t>(group >> bits));
+			}
+		}
+		benchmarkSink = static_cast<long long>(out.size());
+	});
+	report("decode into buffer", text.size(), 3, [&]() {
+		benchmarkSink = static_cast<long long>(jjyou::io::Base64<>::decode(text, decoded));
+	});
+	std::cout << "same bytes: " << (decoded == blob) << std::endl;
+}
+
+int main() {
+	std::cout << "=========== benchmarkAllocator ===========" << std::endl;
+	benchmarkAllocator();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkInSitu ===========" << std::endl;
+	benchmarkInSitu();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkObjectStorage ===========" << std::endl;
+	benchmarkObjectStorage();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkDump ===========" << std::endl;
+	benchmarkDump();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkWriter ===========" << std::endl;
+	benchmarkWriter();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkNumbers ===========" << std::endl;
+	benchmarkNumbers();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkPacked ===========" << std::endl;
+	benchmarkPacked();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkBinary ===========" << std::endl;
+	benchmarkBinary();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkBase64 ===========" << std::endl;
+	benchmarkBase64();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkPath ===========" << std::endl;
+	benchmarkPath();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkParallel ===========" << std::endl;
+	benchmarkParallel();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkPush ===========" << std::endl;
+	benchmarkPush();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkHash ===========" << std::endl;
+	benchmarkHash();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkMove ===========" << std::endl;
+	benchmarkMove();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkNesting ===========" << std::endl;
+	benchmarkNesting();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkBind ===========" << std::endl;
+	benchmarkBind();
+	std::cout << std::endl;
+	std::cout << "=========== benchmarkNdjson ===========" << std::endl;
+	benchmarkNdjson();
+	std::cout << std::endl;
+}
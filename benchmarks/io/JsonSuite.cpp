@@ -0,0 +1,626 @@
+// Regression benchmark of Json: parse, dump, lookup, copy and destroy on a fixed set of corpora,
+// for every Json instantiation used in the library and its examples.
+//
+// Usage: JsonSuite [corpus directory] [repeat]
+//
+// twitter.json, canada.json and citm_catalog.json (the corpora of nativejson-benchmark) are read
+// from the corpus directory when they exist there. Otherwise, and in addition, deterministic
+// look-alikes with the same structure and about the same size are generated, together with a deep
+// and a wide document. The generated corpora do not depend on the library or the platform, so runs
+// of different commits measure the same input.
+//
+// The output is CSV, one line per corpus, instantiation and operation:
+//   corpus       Name of the corpus.
+//   json         Json instantiation, see the aliases below.
+//   operation    parse, dump (compact), lookup (every key of every object), copy or destroy.
+//   bytes        Size of the corpus text. MB/s of every operation is relative to it.
+//   ms           Best time over `repeat` runs.
+//   mb_per_s     bytes / ms.
+//   allocations  Calls to operator new during one run.
+//   alloc_bytes  Bytes requested from operator new during one run.
+//   peak_heap    Peak of the bytes allocated through operator new during one run and not yet freed.
+//   peak_rss_kb  Peak resident set size of the process so far (0 if unsupported).
+
+#include <jjyou/io/Json.hpp>
+#include <jjyou/utils.hpp>
+#include <memory_resource>
+#include <optional>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <charconv>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <new>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+using Json = jjyou::io::Json<int, float, std::string, bool>;
+using Json64 = jjyou::io::Json<long long, double, std::string, bool>;
+using PmrJson = jjyou::io::Json<long long, double, std::pmr::string, bool>;
+using FlatJson = jjyou::io::Json<long long, double, std::string, bool, jjyou::io::JsonFlatObject>;
+using OrderedJson = jjyou::io::Json<long long, double, std::string, bool, jjyou::io::JsonOrderedObject>;
+using InSituJson = jjyou::io::Json<long long, double, std::string_view, bool>;
+
+/*======================================================================
+ | Allocation counting
+ ======================================================================*/
+
+// Every allocation of the program goes through the replaced operator new below, which
+// stores the size in front of the block so that operator delete can account for it.
+// The benchmark is single-threaded. Over-aligned allocations are not counted.
+struct AllocationStats {
+	std::size_t allocations = 0;
+	std::size_t allocatedBytes = 0;
+	std::size_t liveBytes = 0;
+	std::size_t peakBytes = 0;
+};
+AllocationStats allocationStats;
+
+constexpr std::size_t allocationHeader = alignof(std::max_align_t);
+
+void* countedAllocate(std::size_t size) {
+	void* block = std::malloc(size + allocationHeader);
+	if (block == nullptr)
+		throw std::bad_alloc();
+	*static_cast<std::size_t*>(block) = size;
+	++allocationStats.allocations;
+	allocationStats.allocatedBytes += size;
+	allocationStats.liveBytes += size;
+	if (allocationStats.liveBytes > allocationStats.peakBytes)
+		allocationStats.peakBytes = allocationStats.liveBytes;
+	return static_cast<char*>(block) + allocationHeader;
+}
+
+void countedFree(void* ptr) noexcept {
+	if (ptr == nullptr)
+		return;
+	void* block = static_cast<char*>(ptr) - allocationHeader;
+	allocationStats.liveBytes -= *static_cast<std::size_t*>(block);
+	std::free(block);
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try { return countedAllocate(size); }
+	catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try { return countedAllocate(size); }
+	catch (...) { return nullptr; }
+}
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr); }
+
+std::size_t peakRssKb(void) {
+#if defined(__unix__) || defined(__APPLE__)
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+	return static_cast<std::size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+#else
+	return 0;
+#endif
+}
+
+/*======================================================================
+ | Corpora
+ ======================================================================*/
+
+// splitmix64, so that the corpora are the same with every standard library.
+struct Random {
+	std::uint64_t state;
+	std::uint64_t next(void) {
+		std::uint64_t z = (this->state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+	std::uint64_t below(std::uint64_t n) { return this->next() % n; }
+	double uniform(double lo, double hi) { return lo + (hi - lo) * static_cast<double>(this->next() >> 11) * 0x1.0p-53; }
+};
+
+// Minimal JSON text writer for the generators, independent of the library under test.
+class Writer {
+public:
+	explicit Writer(int indent) : indent(indent) {}
+	std::string text;
+	void beginObject(void) { this->value(); this->text += '{'; this->open.push_back(true); }
+	void endObject(void) { this->close('}'); }
+	void beginArray(void) { this->value(); this->text += '['; this->open.push_back(true); }
+	void endArray(void) { this->close(']'); }
+	void key(std::string_view key) {
+		this->separate();
+		this->quote(key);
+		this->text += this->indent > 0 ? ": " : ":";
+		this->afterKey = true;
+	}
+	void string(std::string_view str) { this->value(); this->quote(str); }
+	void raw(std::string_view literal) { this->value(); this->text += literal; }
+	void integer(long long i) { this->raw(std::to_string(i)); }
+	void floating(double d) {
+		char buffer[32];
+		this->raw(std::string_view(buffer, std::to_chars(buffer, buffer + sizeof(buffer), d).ptr - buffer));
+	}
+private:
+	int indent;
+	std::vector<bool> open;
+	bool afterKey = false;
+	void newline(void) {
+		if (this->indent > 0)
+			this->text += '\n' + std::string(this->open.size() * this->indent, ' ');
+	}
+	void separate(void) {
+		if (!this->open.empty()) {
+			if (!this->open.back())
+				this->text += ',';
+			this->open.back() = false;
+			this->newline();
+		}
+	}
+	void value(void) {
+		if (!this->afterKey)
+			this->separate();
+		this->afterKey = false;
+	}
+	void close(char c) {
+		bool empty = this->open.back();
+		this->open.pop_back();
+		if (!empty)
+			this->newline();
+		this->text += c;
+	}
+	void quote(std::string_view str) {
+		this->text += '"';
+		for (char c : str) {
+			if (c == '"' || c == '\\')
+				this->text += '\\';
+			this->text += c;
+		}
+		this->text += '"';
+	}
+};
+
+// Shaped like twitter.json: search results with user profiles, lots of strings and
+// non-ASCII text, both as UTF-8 and as \u escapes, and 64-bit ids.
+std::string makeTwitter(void) {
+	static const char* words[] = {
+		"RT", "@aym0566x", "the", "https://t.co/Ym8nIWXtfn", "#tags", "\\u6f22\\u5b57", "\\ud83d\\ude0a",
+		"\xe3\x81\x8a\xe3\x81\xaf\xe3\x82\x88\xe3\x81\x86", "\xe5\x90\x8d\xe5\x89\x8d", "follow", "\\n", "\\\"quoted\\\"", "me", "today"
+	};
+	Random random{ 1 };
+	auto text = [&](std::size_t count) -> std::string {
+		std::string res;
+		for (std::size_t i = 0; i < count; ++i)
+			res += std::string(i ? " " : "") + words[random.below(std::size(words))];
+		return res;
+	};
+	// `Writer::string` escapes quotes and backslashes, the generated text is already escaped.
+	auto rawString = [](Writer& writer, const std::string& str) -> void { writer.raw("\"" + str + "\""); };
+	Writer writer(2);
+	writer.beginObject();
+	writer.key("statuses");
+	writer.beginArray();
+	for (std::size_t i = 0; i < 200; ++i) {
+		long long id = 505874924095815681LL - static_cast<long long>(random.below(1000000000));
+		long long userId = static_cast<long long>(random.below(3000000000ULL));
+		writer.beginObject();
+		writer.key("metadata");
+		writer.beginObject();
+		writer.key("result_type"); writer.string("recent");
+		writer.key("iso_language_code"); writer.string("ja");
+		writer.endObject();
+		writer.key("created_at"); writer.string("Sun Aug 31 00:29:15 +0000 2014");
+		writer.key("id"); writer.integer(id);
+		writer.key("id_str"); writer.string(std::to_string(id));
+		writer.key("text"); rawString(writer, text(12 + random.below(12)));
+		writer.key("source"); writer.raw("\"<a href=\\\"http://twitter.com/download/iphone\\\" rel=\\\"nofollow\\\">Twitter for iPhone</a>\"");
+		writer.key("truncated"); writer.raw("false");
+		for (const char* key : { "in_reply_to_status_id", "in_reply_to_status_id_str", "in_reply_to_user_id", "in_reply_to_user_id_str", "in_reply_to_screen_name" }) {
+			writer.key(key); writer.raw("null");
+		}
+		writer.key("user");
+		writer.beginObject();
+		writer.key("id"); writer.integer(userId);
+		writer.key("id_str"); writer.string(std::to_string(userId));
+		writer.key("name"); rawString(writer, text(2));
+		writer.key("screen_name"); writer.string("user_" + std::to_string(userId % 100000));
+		writer.key("location"); rawString(writer, text(1));
+		writer.key("description"); rawString(writer, text(10 + random.below(20)));
+		writer.key("url"); writer.raw("null");
+		writer.key("entities");
+		writer.beginObject();
+		writer.key("description");
+		writer.beginObject();
+		writer.key("urls"); writer.beginArray(); writer.endArray();
+		writer.endObject();
+		writer.endObject();
+		writer.key("protected"); writer.raw("false");
+		for (const char* key : { "followers_count", "friends_count", "listed_count", "favourites_count", "statuses_count", "utc_offset" }) {
+			writer.key(key); writer.integer(static_cast<long long>(random.below(100000)));
+		}
+		writer.key("created_at"); writer.string("Sun Mar 31 15:01:08 +0000 2013");
+		writer.key("time_zone"); writer.string("Tokyo");
+		for (const char* key : { "geo_enabled", "verified", "contributors_enabled", "is_translator", "is_translation_enabled", "profile_use_background_image", "default_profile", "default_profile_image", "follow_request_sent", "notifications" }) {
+			writer.key(key); writer.raw(random.below(2) ? "true" : "false");
+		}
+		writer.key("lang"); writer.string("ja");
+		for (const char* key : { "profile_background_color", "profile_link_color", "profile_sidebar_border_color", "profile_sidebar_fill_color", "profile_text_color" }) {
+			writer.key(key); writer.string("C0DEED");
+		}
+		writer.key("profile_image_url"); writer.string("http://pbs.twimg.com/profile_images/" + std::to_string(userId) + "/normal.jpeg");
+		writer.key("profile_image_url_https"); writer.string("https://pbs.twimg.com/profile_images/" + std::to_string(userId) + "/normal.jpeg");
+		writer.endObject();
+		for (const char* key : { "geo", "coordinates", "place", "contributors" }) {
+			writer.key(key); writer.raw("null");
+		}
+		writer.key("retweet_count"); writer.integer(static_cast<long long>(random.below(100)));
+		writer.key("favorite_count"); writer.integer(static_cast<long long>(random.below(100)));
+		writer.key("entities");
+		writer.beginObject();
+		writer.key("hashtags"); writer.beginArray(); writer.endArray();
+		writer.key("symbols"); writer.beginArray(); writer.endArray();
+		writer.key("urls"); writer.beginArray(); writer.endArray();
+		writer.key("user_mentions");
+		writer.beginArray();
+		for (std::size_t j = random.below(3); j > 0; --j) {
+			writer.beginObject();
+			writer.key("screen_name"); writer.string("aym0566x");
+			writer.key("name"); rawString(writer, text(1));
+			writer.key("id"); writer.integer(userId + 1);
+			writer.key("id_str"); writer.string(std::to_string(userId + 1));
+			writer.key("indices");
+			writer.beginArray(); writer.integer(3); writer.integer(12); writer.endArray();
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.endObject();
+		writer.key("favorited"); writer.raw("false");
+		writer.key("retweeted"); writer.raw("false");
+		writer.key("lang"); writer.string("ja");
+		writer.endObject();
+	}
+	writer.endArray();
+	writer.key("search_metadata");
+	writer.beginObject();
+	writer.key("completed_in"); writer.floating(0.087);
+	writer.key("max_id"); writer.integer(505874924095815681LL);
+	writer.key("query"); writer.string("%E4%B8%80");
+	writer.key("count"); writer.integer(100);
+	writer.endObject();
+	writer.endObject();
+	return writer.text;
+}
+
+// Shaped like canada.json: a GeoJSON polygon with about 110k full-precision coordinates.
+std::string makeCanada(void) {
+	Random random{ 2 };
+	Writer writer(0);
+	writer.beginObject();
+	writer.key("type"); writer.string("FeatureCollection");
+	writer.key("features");
+	writer.beginArray();
+	writer.beginObject();
+	writer.key("type"); writer.string("Feature");
+	writer.key("properties");
+	writer.beginObject();
+	writer.key("name"); writer.string("Canada");
+	writer.endObject();
+	writer.key("geometry");
+	writer.beginObject();
+	writer.key("type"); writer.string("Polygon");
+	writer.key("coordinates");
+	writer.beginArray();
+	for (std::size_t ring = 0; ring < 480; ++ring) {
+		double x = random.uniform(-141.0, -52.0), y = random.uniform(42.0, 83.0);
+		writer.beginArray();
+		for (std::size_t point = 0; point < 116; ++point) {
+			x += random.uniform(-0.01, 0.01);
+			y += random.uniform(-0.01, 0.01);
+			writer.beginArray(); writer.floating(x); writer.floating(y); writer.endArray();
+		}
+		writer.endArray();
+	}
+	writer.endArray();
+	writer.endObject();
+	writer.endObject();
+	writer.endArray();
+	writer.endObject();
+	return writer.text;
+}
+
+// Shaped like citm_catalog.json: pretty-printed tables of names keyed by numeric ids,
+// and event records with small nested arrays.
+std::string makeCitm(void) {
+	Random random{ 3 };
+	auto id = [&](void) -> long long { return 100000000LL + static_cast<long long>(random.below(900000000)); };
+	auto table = [&](Writer& writer, const char* name, std::size_t count, const char* prefix) -> void {
+		writer.key(name);
+		writer.beginObject();
+		for (std::size_t i = 0; i < count; ++i) {
+			writer.key(std::to_string(id()));
+			writer.string(std::string(prefix) + " " + std::to_string(i) + " \xc3\xa9tage");
+		}
+		writer.endObject();
+	};
+	Writer writer(4);
+	writer.beginObject();
+	table(writer, "areaNames", 17, "Arri\xc3\xa8re-sc\xc3\xa8ne");
+	table(writer, "audienceSubCategoryNames", 1, "Abonnement");
+	writer.key("blockNames"); writer.beginObject(); writer.endObject();
+	writer.key("events");
+	writer.beginObject();
+	for (std::size_t i = 0; i < 184; ++i) {
+		long long eventId = id();
+		writer.key(std::to_string(eventId));
+		writer.beginObject();
+		writer.key("description"); writer.raw("null");
+		writer.key("id"); writer.integer(eventId);
+		writer.key("logo"); writer.raw(random.below(2) ? "null" : "\"/images/UE0AAAAACEKo6QAAAAZDSVRN\"");
+		writer.key("name"); writer.string("Concert " + std::to_string(i));
+		writer.key("subTopicIds");
+		writer.beginArray();
+		for (std::size_t j = 0, count = 2 + random.below(4); j < count; ++j) writer.integer(337184262 + static_cast<long long>(random.below(100)));
+		writer.endArray();
+		writer.key("subjectCode"); writer.raw("null");
+		writer.key("subtitle"); writer.raw("null");
+		writer.key("topicIds");
+		writer.beginArray();
+		for (std::size_t j = 0, count = 1 + random.below(3); j < count; ++j) writer.integer(324846099 + static_cast<long long>(random.below(100)));
+		writer.endArray();
+		writer.endObject();
+	}
+	writer.endObject();
+	writer.key("performances");
+	writer.beginArray();
+	for (std::size_t i = 0; i < 243; ++i) {
+		writer.beginObject();
+		writer.key("eventId"); writer.integer(id());
+		writer.key("id"); writer.integer(id());
+		writer.key("logo"); writer.raw("null");
+		writer.key("name"); writer.raw("null");
+		writer.key("prices");
+		writer.beginArray();
+		for (std::size_t j = 0, count = 2 + random.below(8); j < count; ++j) {
+			writer.beginObject();
+			writer.key("amount"); writer.integer(static_cast<long long>(10000 + 500 * random.below(200)));
+			writer.key("audienceSubCategoryId"); writer.integer(337100890);
+			writer.key("seatCategoryId"); writer.integer(id());
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.key("seatCategories");
+		writer.beginArray();
+		for (std::size_t j = 0, count = 2 + random.below(8); j < count; ++j) {
+			writer.beginObject();
+			writer.key("areas");
+			writer.beginArray();
+			for (std::size_t k = 0, count = 1 + random.below(12); k < count; ++k) {
+				writer.beginObject();
+				writer.key("areaId"); writer.integer(205705993 + static_cast<long long>(random.below(100)));
+				writer.key("blockIds"); writer.beginArray(); writer.endArray();
+				writer.endObject();
+			}
+			writer.endArray();
+			writer.key("seatCategoryId"); writer.integer(id());
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.key("seatMapImage"); writer.raw("null");
+		writer.key("start"); writer.integer(1372616400000LL + 86400000LL * static_cast<long long>(i));
+		writer.key("venueCode"); writer.string("PLEYEL_PLEYEL");
+		writer.endObject();
+	}
+	writer.endArray();
+	table(writer, "seatCategoryNames", 64, "Cat\xc3\xa9gorie");
+	table(writer, "subTopicNames", 19, "Musique classique");
+	writer.key("subjectNames"); writer.beginObject(); writer.endObject();
+	table(writer, "topicNames", 4, "Genre");
+	writer.key("topicSubTopics");
+	writer.beginObject();
+	for (std::size_t i = 0; i < 4; ++i) {
+		writer.key(std::to_string(324846099 + i));
+		writer.beginArray();
+		for (std::size_t j = 0; j < 5; ++j) writer.integer(337184262 + static_cast<long long>(j));
+		writer.endArray();
+	}
+	writer.endObject();
+	writer.key("venueNames");
+	writer.beginObject();
+	writer.key("PLEYEL_PLEYEL"); writer.string("Salle Pleyel");
+	writer.endObject();
+	writer.endObject();
+	return writer.text;
+}
+
+// 256 chains nested 256 levels deep, alternating objects and arrays.
+std::string makeDeep(void) {
+	Writer writer(0);
+	writer.beginArray();
+	for (std::size_t i = 0; i < 256; ++i) {
+		for (std::size_t depth = 0; depth < 128; ++depth) {
+			writer.beginObject();
+			writer.key("a");
+			writer.beginArray();
+		}
+		writer.integer(static_cast<long long>(i));
+		for (std::size_t depth = 0; depth < 128; ++depth) {
+			writer.endArray();
+			writer.endObject();
+		}
+	}
+	writer.endArray();
+	return writer.text;
+}
+
+// One object with 20k members in random order, each an array of 16 scalars.
+std::string makeWide(void) {
+	Random random{ 5 };
+	Writer writer(0);
+	writer.beginObject();
+	for (std::size_t i = 0; i < 20000; ++i) {
+		writer.key("member_" + std::to_string(random.next() % 100000000));
+		writer.beginArray();
+		for (std::size_t j = 0; j < 4; ++j) {
+			writer.integer(static_cast<long long>(i * 4 + j));
+			writer.floating(static_cast<double>(i * 4 + j) * 0.25);
+			writer.raw(j % 2 ? "true" : "null");
+			writer.string("value");
+		}
+		writer.endArray();
+	}
+	writer.endObject();
+	return writer.text;
+}
+
+struct Corpus {
+	std::string name;
+	std::string text;
+};
+
+std::vector<Corpus> loadCorpora(const std::filesystem::path& directory) {
+	std::vector<Corpus> res;
+	if (!directory.empty()) {
+		for (const char* name : { "twitter.json", "canada.json", "citm_catalog.json" }) {
+			std::ifstream file(directory / name, std::ios::binary);
+			if (!file)
+				continue;
+			std::ostringstream text;
+			text << file.rdbuf();
+			res.push_back(Corpus{ name, text.str() });
+		}
+	}
+	res.push_back(Corpus{ "synthetic_twitter", makeTwitter() });
+	res.push_back(Corpus{ "synthetic_canada", makeCanada() });
+	res.push_back(Corpus{ "synthetic_citm", makeCitm() });
+	res.push_back(Corpus{ "synthetic_deep", makeDeep() });
+	res.push_back(Corpus{ "synthetic_wide", makeWide() });
+	return res;
+}
+
+/*======================================================================
+ | Measurements
+ ======================================================================*/
+
+// Results of the measured operations are stored here so that they are not optimized away.
+volatile long long benchmarkSink = 0;
+
+// A parsed corpus, together with the memory its strings or nodes are allocated from.
+template <class JsonTy>
+struct Document {
+	JsonTy json;
+	explicit Document(const std::string& src) : json(JsonTy::parse(src)) {}
+};
+
+template <>
+struct Document<PmrJson> {
+	std::pmr::monotonic_buffer_resource arena;
+	PmrJson json;
+	explicit Document(const std::string& src) : arena(src.size() * 4), json(PmrJson::parse(src, &arena)) {}
+};
+
+template <>
+struct Document<InSituJson> {
+	jjyou::io::JsonStringArena<char> arena;
+	InSituJson json;
+	explicit Document(const std::string& src) : arena(), json(InSituJson::parse(src, arena)) {}
+};
+
+// Run `setup` and `func` `repeat` times, time `func` and report its best time. The
+// allocations are those of the first run.
+template <class Setup, class Func>
+void measure(const Corpus& corpus, const char* json, const char* operation, int repeat, Setup&& setup, Func&& func) {
+	jjyou::utils::Clock clock;
+	double best = 0.0;
+	AllocationStats stats;
+	for (int i = 0; i < repeat; ++i) {
+		setup();
+		AllocationStats before = allocationStats;
+		allocationStats.peakBytes = allocationStats.liveBytes;
+		clock.begin();
+		func();
+		double seconds = clock.end();
+		if (i == 0) {
+			stats.allocations = allocationStats.allocations - before.allocations;
+			stats.allocatedBytes = allocationStats.allocatedBytes - before.allocatedBytes;
+			stats.peakBytes = allocationStats.peakBytes - before.liveBytes;
+		}
+		allocationStats.peakBytes = std::max(allocationStats.peakBytes, before.peakBytes);
+		if (i == 0 || seconds < best) best = seconds;
+	}
+	std::cout << corpus.name << "," << json << "," << operation << "," << corpus.text.size() << ","
+		<< best * 1000.0 << "," << static_cast<double>(corpus.text.size()) / best / 1e6 << ","
+		<< stats.allocations << "," << stats.allocatedBytes << "," << stats.peakBytes << "," << peakRssKb() << std::endl;
+}
+
+// Collect every object and its keys, for the lookup benchmark.
+template <class JsonTy>
+void collectKeys(const JsonTy& json, std::vector<std::pair<const JsonTy*, typename JsonTy::StringType>>& keys) {
+	if (json.type() == jjyou::io::JsonType::Object) {
+		for (auto iter = json.begin(); iter != json.end(); ++iter) {
+			keys.emplace_back(&json, iter.key());
+			collectKeys(*iter, keys);
+		}
+	}
+	else if (json.type() == jjyou::io::JsonType::Array) {
+		for (const JsonTy& element : json)
+			collectKeys(element, keys);
+	}
+}
+
+template <class JsonTy>
+void benchmarkJson(const Corpus& corpus, const char* json, int repeat) {
+	std::optional<Document<JsonTy>> document;
+	auto none = [](void) -> void {};
+	measure(corpus, json, "parse", repeat, [&]() { document.reset(); }, [&]() {
+		document.emplace(corpus.text);
+	});
+	typename JsonTy::DumpOptions compact;
+	compact.pretty = false;
+	measure(corpus, json, "dump", repeat, none, [&]() {
+		benchmarkSink = static_cast<long long>(document->json.dump(compact).size());
+	});
+	std::vector<std::pair<const JsonTy*, typename JsonTy::StringType>> keys;
+	collectKeys(document->json, keys);
+	measure(corpus, json, "lookup", repeat, none, [&]() {
+		long long sink = 0;
+		for (const auto& [object, key] : keys)
+			sink += static_cast<long long>(object->find(key)->type());
+		benchmarkSink = sink;
+	});
+	keys.clear();
+	keys.shrink_to_fit();
+	std::optional<JsonTy> copy;
+	measure(corpus, json, "copy", repeat, [&]() { copy.reset(); }, [&]() {
+		copy.emplace(document->json);
+	});
+	copy.reset();
+	measure(corpus, json, "destroy", repeat, [&]() { document.emplace(corpus.text); }, [&]() {
+		document.reset();
+	});
+}
+
+int main(int argc, char* argv[]) {
+	std::filesystem::path directory = (argc > 1) ? argv[1] : "";
+	int repeat = (argc > 2) ? std::max(std::atoi(argv[2]), 1) : 5;
+	std::vector<Corpus> corpora = loadCorpora(directory);
+	std::cout << "corpus,json,operation,bytes,ms,mb_per_s,allocations,alloc_bytes,peak_heap,peak_rss_kb" << std::endl;
+	for (const Corpus& corpus : corpora) {
+		benchmarkJson<Json>(corpus, "Json", repeat);
+		benchmarkJson<Json64>(corpus, "Json64", repeat);
+		benchmarkJson<PmrJson>(corpus, "PmrJson", repeat);
+		benchmarkJson<FlatJson>(corpus, "FlatJson", repeat);
+		benchmarkJson<OrderedJson>(corpus, "OrderedJson", repeat);
+		benchmarkJson<InSituJson>(corpus, "InSituJson", repeat);
+	}
+	return 0;
+}
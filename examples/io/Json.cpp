@@ -264,6 +264,36 @@ void exampleWrite(void) {
 	
 }
 
+// Handler for `Json::sax`. Counts the frames in a camera log without building a Json container.
+struct FrameCounter {
+	int depth = 0;
+	int frames = 0;
+	void onNull(void) {}
+	void onInteger(int) {}
+	void onFloating(float) {}
+	void onBool(bool) {}
+	void onString(std::string_view) {}
+	void onKey(std::string_view) {}
+	void onStartArray(void) { ++this->depth; }
+	void onEndArray(void) { --this->depth; }
+	void onStartObject(void) { if (this->depth++ == 1) ++this->frames; }
+	void onEndObject(void) { --this->depth; }
+};
+
+void exampleSax(void) {
+	
+	FrameCounter counter;
+	Json::sax(std::string_view(R"(
+[
+	{"frame" : 0, "pose" : [0.0, 0.0, 0.0]},
+	{"frame" : 1, "pose" : [0.1, 0.0, 0.0]},
+	{"frame" : 2, "pose" : [0.2, 0.0, 0.0]}
+]
+	)"), counter);								///Files and streams can be passed as well, as in `Json::parse`.
+	std::cout << counter.frames << std::endl;	// 3
+	
+}
+
 int main() {
 	std::cout << "=========== exampleConstruct ===========" << std::endl;
 	exampleConstruct();
@@ -283,4 +313,7 @@ int main() {
 	std::cout << "=========== exampleWrite ===========" << std::endl;
 	exampleWrite();
 	std::cout << std::endl;
+	std::cout << "=========== exampleSax ===========" << std::endl;
+	exampleSax();
+	std::cout << std::endl;
 }
\ No newline at end of file
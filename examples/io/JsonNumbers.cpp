@@ -0,0 +1,131 @@
+// Table-driven check of the numbers read by Json::parse: integer limits and promotion to
+// floating point, signed zeros, subnormals, overflow, long mantissas, the non-standard forms
+// accepted by the lexer, and the error messages of malformed numbers.
+//
+// Every case is parsed from a string and from a stream, with and without
+// `ParseOptions::lazyNumbers`. The program prints the failing cases and returns
+// EXIT_FAILURE if there are any.
+
+#include <jjyou/io/Json.hpp>
+#include <sstream>
+#include <functional>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+using Json = jjyou::io::Json<long long, double, std::string, bool>;
+using jjyou::io::JsonType;
+
+struct NumberCase {
+	const char* text;
+	JsonType type;				// Integer, Floating, or Null if parsing must fail.
+	long long integer;
+	double floating;			// Compared bit by bit, so that the sign of zero matters.
+	const char* error;
+};
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+const NumberCase numberCases[] = {
+	// Limits of IntegerType. One past them is promoted to FloatingType.
+	{ "9223372036854775807", JsonType::Integer, std::numeric_limits<long long>::max(), 0.0, nullptr },
+	{ "-9223372036854775808", JsonType::Integer, std::numeric_limits<long long>::min(), 0.0, nullptr },
+	{ "9223372036854775808", JsonType::Floating, 0, 9223372036854775808.0, nullptr },
+	{ "-9223372036854775809", JsonType::Floating, 0, -9223372036854775809.0, nullptr },
+	// Signed zeros.
+	{ "-0", JsonType::Integer, 0, 0.0, nullptr },
+	{ "-0.0", JsonType::Floating, 0, -0.0, nullptr },
+	{ "0e-5", JsonType::Floating, 0, 0.0, nullptr },
+	// Subnormals and the smallest normal number.
+	{ "4.9e-324", JsonType::Floating, 0, 4.9e-324, nullptr },
+	{ "2.2250738585072011e-308", JsonType::Floating, 0, 2.2250738585072011e-308, nullptr },
+	{ "2.2250738585072014e-308", JsonType::Floating, 0, 2.2250738585072014e-308, nullptr },
+	// Overflow gives infinity, underflow gives zero.
+	{ "1e400", JsonType::Floating, 0, inf, nullptr },
+	{ "-1e400", JsonType::Floating, 0, -inf, nullptr },
+	{ "1.8e308", JsonType::Floating, 0, inf, nullptr },
+	{ "1.7976931348623157e308", JsonType::Floating, 0, 1.7976931348623157e308, nullptr },
+	{ "1e-400", JsonType::Floating, 0, 0.0, nullptr },
+	{ "-1e-400", JsonType::Floating, 0, -0.0, nullptr },
+	// More digits than fit in a double are rounded correctly.
+	{ "3.14159265358979323846264338327950288419716939937510", JsonType::Floating, 0, 3.14159265358979323846264338327950288419716939937510, nullptr },
+	{ "123456789012345678901234567890", JsonType::Floating, 0, 123456789012345678901234567890.0, nullptr },
+	{ "0.1", JsonType::Floating, 0, 0.1, nullptr },
+	// Exponents.
+	{ "1E+2", JsonType::Floating, 0, 100.0, nullptr },
+	{ "1e-5", JsonType::Floating, 0, 1e-5, nullptr },
+	{ "-2.5E3", JsonType::Floating, 0, -2500.0, nullptr },
+	// Non-standard forms accepted by the lexer. Fractional exponents are evaluated with `std::pow`.
+	{ "1e2.5", JsonType::Floating, 0, std::pow(10.0, 2.5), nullptr },
+	{ "+1", JsonType::Integer, 1, 0.0, nullptr },
+	{ ".5", JsonType::Floating, 0, 0.5, nullptr },
+	{ "5.", JsonType::Floating, 0, 5.0, nullptr },
+	{ "01", JsonType::Integer, 1, 0.0, nullptr },
+	// Malformed numbers.
+	{ "[1e]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \"1e\"." },
+	{ "[1e+]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \"1e+\"." },
+	{ "[1e.]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \"1e.\"." },
+	{ "[1ee2]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \"1e\"." },
+	{ "[-]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \"-\"." },
+	{ "[-.]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \"-.\"." },
+	{ "[--1]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \"-\"." },
+	{ "[.]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:2, pos:2 Unexpected characters \".\"." },
+	{ "[0x10]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:3, pos:3 Unexpected characters \"x\"." },
+	{ "[1.2.3]", JsonType::Null, 0, 0.0, "[Json Parser] ln:1, col:5, pos:5 Missing comma to separate elements in an array." },
+	{ "[1,\n 2e]", JsonType::Null, 0, 0.0, "[Json Parser] ln:2, col:2, pos:6 Unexpected characters \"2e\"." },
+};
+
+// Compare the result of one parse with the expected one. Return an empty string on success.
+std::string checkNumber(const NumberCase& test, const std::function<Json(void)>& parse) {
+	Json json;
+	try {
+		json = parse();
+	}
+	catch (const std::exception& e) {
+		if (test.error == nullptr)
+			return std::string("unexpected error: ") + e.what();
+		if (std::string(e.what()) != test.error)
+			return std::string("wrong error: ") + e.what();
+		return std::string();
+	}
+	if (test.error != nullptr)
+		return "no error, parsed " + json.dump(Json::DumpOptions{ false });
+	if (json.type() != test.type)
+		return "wrong type, parsed " + json.dump(Json::DumpOptions{ false });
+	if (test.type == JsonType::Integer && json.integer() != test.integer)
+		return "wrong value " + std::to_string(json.integer());
+	if (test.type == JsonType::Floating && std::bit_cast<std::uint64_t>(json.floating()) != std::bit_cast<std::uint64_t>(test.floating)) {
+		std::ostringstream sstream;
+		sstream.precision(17);
+		sstream << "wrong value " << json.floating();
+		return sstream.str();
+	}
+	return std::string();
+}
+
+int main() {
+	std::size_t failures = 0;
+	for (const NumberCase& test : numberCases) {
+		for (bool lazy : { false, true }) {
+			Json::ParseOptions options;
+			options.lazyNumbers = lazy;
+			const std::string fromString = checkNumber(test, [&]() -> Json {
+				return Json::parse(std::string(test.text), options);
+			});
+			const std::string fromStream = checkNumber(test, [&]() -> Json {
+				std::istringstream stream(test.text);
+				return Json::parse(stream, options);
+			});
+			for (const std::string* result : { &fromString, &fromStream }) {
+				if (result->empty())
+					continue;
+				++failures;
+				std::cout << "FAIL \"" << test.text << "\" (" << (result == &fromString ? "string" : "stream")
+					<< (lazy ? ", lazy" : "") << "): " << *result << std::endl;
+			}
+		}
+	}
+	std::cout << (sizeof(numberCases) / sizeof(numberCases[0])) << " cases, " << failures << " failures" << std::endl;
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,361 @@
+/***********************************************************************
+ * @file	Base64.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements Base64 class.
+***********************************************************************/
+#ifndef jjyou_io_Base64_hpp
+#define jjyou_io_Base64_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @class	Base64
+		 * @brief	Base64 (RFC 4648) encoder and decoder for binary data embedded in json strings.
+		 *
+		 * Strings are passed as `std::basic_string_view<CharTy>`, so the strings of
+		 * a Json container can be decoded in place, e.g. the buffers of a glTF asset:
+		 * @code
+		 * std::optional<std::string_view> payload = Base64<>::dataUriPayload(buffer["uri"].string());
+		 * std::vector<std::uint8_t> bytes(Base64<>::decodedSize(*payload));
+		 * Base64<>::decode(*payload, bytes);
+		 * @endcode
+		 *
+		 * Decoded bytes are written directly into the caller's buffer, and encoded
+		 * characters directly into the caller's string, without temporary copies.
+		 * With AVX2 (or SSSE3) enabled at compile time, e.g. with `-mavx2`, 1-byte
+		 * characters are encoded 24 (12) bytes and decoded 32 (16) characters at a
+		 * time, in the style of Muła and Lemire. Other builds use a scalar table
+		 * lookup. The results and the errors are the same.
+		 *
+		 * Encoded strings are padded with '='. The decoder also accepts strings without
+		 * padding, but no other characters, such as whitespace or line breaks.
+		 * Invalid input is reported by throwing std::runtime_error.
+		 *
+		 * @tparam	CharTy	The character type. Default is `char`.
+		 ***********************************************************************/
+		template <class CharTy = char>
+		class Base64 {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using CharType = CharTy;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Get the length of the encoding of `size` bytes, including padding.
+			  */
+			static constexpr std::size_t encodedSize(std::size_t size) {
+				return (size + 2) / 3 * 4;
+			}
+
+			/** @brief	Get the number of bytes encoded by `text`.
+			  *
+			  * The characters are not validated, `decode` does it.
+			  */
+			static std::size_t decodedSize(StringViewType text);
+
+			/** @brief	Encode `data` into `out`, which must have room for `encodedSize(data.size())` characters.
+			  */
+			static void encode(std::span<const std::uint8_t> data, CharType* out);
+
+			/** @brief	Encode `data` into a string.
+			  */
+			template <class StringTy = std::basic_string<CharTy>>
+			static StringTy encode(std::span<const std::uint8_t> data) {
+				StringTy res(Base64::encodedSize(data.size()), CharType());
+				Base64::encode(data, res.data());
+				return res;
+			}
+
+			/** @brief	Decode `text` into `out`.
+			  *
+			  * If `out` is smaller than `decodedSize(text)`, an exception of type
+			  * std::out_of_range is thrown. If `text` is not valid base64, an exception
+			  * of type std::runtime_error is thrown, and the content of `out` is unspecified.
+			  * @return	The number of decoded bytes, `decodedSize(text)`.
+			  */
+			static std::size_t decode(StringViewType text, std::span<std::uint8_t> out);
+
+			/** @brief	Decode `text` into a vector.
+			  */
+			static std::vector<std::uint8_t> decode(StringViewType text) {
+				std::vector<std::uint8_t> res(Base64::decodedSize(text));
+				Base64::decode(text, res);
+				return res;
+			}
+
+			/** @brief	Get the base64 payload of a data URI, e.g. "data:application/octet-stream;base64,AAAA".
+			  * @return	The text after ";base64,", or `std::nullopt` if `uri` is not a base64 data URI,
+			  *			e.g. a relative path to an external file.
+			  */
+			static std::optional<StringViewType> dataUriPayload(StringViewType uri);
+
+		private:
+
+			static constexpr char _alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			// 6-bit values of the characters, 0xFF for invalid characters.
+			static constexpr std::uint8_t _invalid = 0xFF;
+			static constexpr auto _values = []() {
+				std::array<std::uint8_t, 256> res{};
+				for (std::uint8_t& value : res)
+					value = _invalid;
+				for (std::uint8_t i = 0; i < 64; ++i)
+					res[static_cast<unsigned char>(_alphabet[i])] = i;
+				return res;
+			}();
+			static std::uint8_t _value(CharType c) {
+				if constexpr (sizeof(CharType) > 1) {
+					if (static_cast<std::make_unsigned_t<CharType>>(c) > 0xFF)
+						return _invalid;
+				}
+				return _values[static_cast<unsigned char>(c)];
+			}
+			[[noreturn]] static void _error(std::size_t pos, const char* msg);
+
+		};
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class CharTy>
+		inline std::size_t Base64<CharTy>::decodedSize(StringViewType text) {
+			std::size_t length = text.size();
+			if (length != 0 && text[length - 1] == static_cast<CharType>('='))
+				--length;
+			if (length != 0 && text[length - 1] == static_cast<CharType>('='))
+				--length;
+			// A trailing group of 2 or 3 characters holds 1 or 2 bytes.
+			return length / 4 * 3 + (length % 4 == 0 ? 0 : length % 4 - 1);
+		}
+
+		template <class CharTy>
+		inline void Base64<CharTy>::encode(std::span<const std::uint8_t> data, CharType* out) {
+			const std::uint8_t* first = data.data();
+			const std::uint8_t* last = first + data.size();
+			if constexpr (sizeof(CharType) == 1) {
+#if defined(__AVX2__) || defined(__SSSE3__)
+				// Split each 3 bytes into four 6-bit indices, one per byte, then map the
+				// indices to the alphabet with an offset looked up by their range.
+				auto encode16 = [](__m128i in) -> __m128i {
+					in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+					const __m128i high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+					const __m128i low = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+					const __m128i indices = _mm_or_si128(high, low);
+					// 0 for 'a'-'z', 1-10 for '0'-'9', 11 for '+', 12 for '/', 13 for 'A'-'Z'.
+					__m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+					range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+					const __m128i offsets = _mm_setr_epi8(
+						'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+						'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+					);
+					return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+				};
+#if defined(__AVX2__)
+				// 24 bytes per iteration. The loads read 4 bytes beyond them.
+				for (; last - first >= 28; first += 24, out += 32) {
+					const __m128i lo = encode16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)));
+					const __m128i hi = encode16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + 12)));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+				}
+#endif
+				// 12 bytes per iteration. The load reads 4 bytes beyond them.
+				for (; last - first >= 16; first += 12, out += 16)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out), encode16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))));
+#endif
+			}
+			for (; last - first >= 3; first += 3, out += 4) {
+				const std::uint32_t group = (static_cast<std::uint32_t>(first[0]) << 16) | (static_cast<std::uint32_t>(first[1]) << 8) | first[2];
+				out[0] = static_cast<CharType>(_alphabet[(group >> 18) & 0x3F]);
+				out[1] = static_cast<CharType>(_alphabet[(group >> 12) & 0x3F]);
+				out[2] = static_cast<CharType>(_alphabet[(group >> 6) & 0x3F]);
+				out[3] = static_cast<CharType>(_alphabet[group & 0x3F]);
+			}
+			if (last - first == 1) {
+				out[0] = static_cast<CharType>(_alphabet[first[0] >> 2]);
+				out[1] = static_cast<CharType>(_alphabet[(first[0] & 0x03) << 4]);
+				out[2] = static_cast<CharType>('=');
+				out[3] = static_cast<CharType>('=');
+			}
+			else if (last - first == 2) {
+				out[0] = static_cast<CharType>(_alphabet[first[0] >> 2]);
+				out[1] = static_cast<CharType>(_alphabet[((first[0] & 0x03) << 4) | (first[1] >> 4)]);
+				out[2] = static_cast<CharType>(_alphabet[(first[1] & 0x0F) << 2]);
+				out[3] = static_cast<CharType>('=');
+			}
+		}
+
+		template <class CharTy>
+		inline std::size_t Base64<CharTy>::decode(StringViewType text, std::span<std::uint8_t> out) {
+			const std::size_t size = Base64::decodedSize(text);
+			if (out.size() < size)
+				throw std::out_of_range("`Base64::decode(StringViewType, std::span<std::uint8_t>)` needs an output buffer of `decodedSize(text)` bytes.");
+			std::size_t length = text.size();
+			if (length % 4 == 1)
+				Base64::_error(length, "Truncated input.");
+			if (length % 4 == 0 && length != 0) {
+				// Padding only completes the last group.
+				if (text[length - 1] == static_cast<CharType>('='))
+					--length;
+				if (text[length - 1] == static_cast<CharType>('='))
+					--length;
+			}
+			const CharType* begin = text.data();
+			const CharType* first = begin;
+			const CharType* last = begin + length;
+			std::uint8_t* dst = out.data();
+			if constexpr (sizeof(CharType) == 1) {
+#if defined(__AVX2__) || defined(__SSSE3__)
+				// Characters are validated by their low and high nibbles with two table
+				// lookups, mapped to 6-bit values by an offset looked up by their high nibble,
+				// and packed 4 to 3 bytes with multiply-adds.
+#if defined(__AVX2__)
+				using Vector = __m256i;
+				auto broadcast = [](__m128i table) -> Vector { return _mm256_broadcastsi128_si256(table); };
+				auto set1 = [](char c) -> Vector { return _mm256_set1_epi8(c); };
+				auto set1_32 = [](int i) -> Vector { return _mm256_set1_epi32(i); };
+				auto shuffle = [](Vector table, Vector index) -> Vector { return _mm256_shuffle_epi8(table, index); };
+				auto andBits = [](Vector a, Vector b) -> Vector { return _mm256_and_si256(a, b); };
+				auto add = [](Vector a, Vector b) -> Vector { return _mm256_add_epi8(a, b); };
+				auto shiftRight4 = [](Vector v) -> Vector { return _mm256_srli_epi32(v, 4); };
+				auto equal = [](Vector a, Vector b) -> Vector { return _mm256_cmpeq_epi8(a, b); };
+				auto invalid = [](Vector v) -> bool { return _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256())) != -1; };
+				auto maddubs = [](Vector a, Vector b) -> Vector { return _mm256_maddubs_epi16(a, b); };
+				auto madd = [](Vector a, Vector b) -> Vector { return _mm256_madd_epi16(a, b); };
+				auto load = [](const CharType* p) -> Vector { return _mm256_loadu_si256(reinterpret_cast<const Vector*>(p)); };
+				auto store = [](std::uint8_t* p, Vector v) -> void {
+					// Each lane holds 12 bytes.
+					_mm256_storeu_si256(reinterpret_cast<Vector*>(p), _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)));
+				};
+#else
+				using Vector = __m128i;
+				auto broadcast = [](__m128i table) -> Vector { return table; };
+				auto set1 = [](char c) -> Vector { return _mm_set1_epi8(c); };
+				auto set1_32 = [](int i) -> Vector { return _mm_set1_epi32(i); };
+				auto shuffle = [](Vector table, Vector index) -> Vector { return _mm_shuffle_epi8(table, index); };
+				auto andBits = [](Vector a, Vector b) -> Vector { return _mm_and_si128(a, b); };
+				auto add = [](Vector a, Vector b) -> Vector { return _mm_add_epi8(a, b); };
+				auto shiftRight4 = [](Vector v) -> Vector { return _mm_srli_epi32(v, 4); };
+				auto equal = [](Vector a, Vector b) -> Vector { return _mm_cmpeq_epi8(a, b); };
+				auto invalid = [](Vector v) -> bool { return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF; };
+				auto maddubs = [](Vector a, Vector b) -> Vector { return _mm_maddubs_epi16(a, b); };
+				auto madd = [](Vector a, Vector b) -> Vector { return _mm_madd_epi16(a, b); };
+				auto load = [](const CharType* p) -> Vector { return _mm_loadu_si128(reinterpret_cast<const Vector*>(p)); };
+				auto store = [](std::uint8_t* p, Vector v) -> void { _mm_storeu_si128(reinterpret_cast<Vector*>(p), v); };
+#endif
+				constexpr std::size_t width = sizeof(Vector);
+				const Vector lowTable = broadcast(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+				const Vector highTable = broadcast(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+				const Vector offsetTable = broadcast(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+				const Vector packTable = broadcast(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+				const Vector nibble = set1(0x0F);
+				const Vector slash = set1('/');
+				// Each iteration stores `width` bytes, of which 3/4 are decoded. Stop while
+				// the store still fits in the output, i.e. before the last half `width`.
+				for (; static_cast<std::size_t>(last - first) >= width + width / 2; first += width, dst += width / 4 * 3) {
+					Vector in = load(first);
+					const Vector high = andBits(shiftRight4(in), nibble);
+					if (invalid(andBits(shuffle(lowTable, andBits(in, nibble)), shuffle(highTable, high))))
+						break;
+					// '/' shares its high nibble with '+', its offset is one entry before.
+					in = add(in, shuffle(offsetTable, add(equal(in, slash), high)));
+					in = madd(maddubs(in, set1_32(0x01400140)), set1_32(0x00011000));
+					store(dst, shuffle(in, packTable));
+				}
+#endif
+			}
+			// The rest, and the block with an invalid character, which is reported by position.
+			for (; last - first >= 4; first += 4, dst += 3) {
+				const std::uint8_t a = Base64::_value(first[0]), b = Base64::_value(first[1]), c = Base64::_value(first[2]), d = Base64::_value(first[3]);
+				if ((a | b | c | d) == _invalid) {
+					for (std::size_t i = 0; i < 4; ++i)
+						if (Base64::_value(first[i]) == _invalid)
+							Base64::_error(static_cast<std::size_t>(first - begin) + i, "Invalid character.");
+				}
+				const std::uint32_t group = (static_cast<std::uint32_t>(a) << 18) | (static_cast<std::uint32_t>(b) << 12) | (static_cast<std::uint32_t>(c) << 6) | d;
+				dst[0] = static_cast<std::uint8_t>(group >> 16);
+				dst[1] = static_cast<std::uint8_t>(group >> 8);
+				dst[2] = static_cast<std::uint8_t>(group);
+			}
+			if (last - first >= 2) {
+				std::uint32_t group = 0;
+				for (std::ptrdiff_t i = 0; i < last - first; ++i) {
+					const std::uint8_t value = Base64::_value(first[i]);
+					if (value == _invalid)
+						Base64::_error(static_cast<std::size_t>(first - begin + i), "Invalid character.");
+					group |= static_cast<std::uint32_t>(value) << (18 - 6 * i);
+				}
+				// The unused bits of the last character must be zero.
+				if ((last - first == 2 && (group & 0x00FFFF) != 0) || (last - first == 3 && (group & 0x0000FF) != 0))
+					Base64::_error(static_cast<std::size_t>(last - begin - 1), "Non-canonical encoding.");
+				dst[0] = static_cast<std::uint8_t>(group >> 16);
+				if (last - first == 3)
+					dst[1] = static_cast<std::uint8_t>(group >> 8);
+			}
+			else if (last != first) {
+				Base64::_error(static_cast<std::size_t>(last - begin), "Truncated input.");
+			}
+			return size;
+		}
+
+		template <class CharTy>
+		inline std::optional<typename Base64<CharTy>::StringViewType> Base64<CharTy>::dataUriPayload(StringViewType uri) {
+			auto startsWith = [](StringViewType text, const char* prefix) -> bool {
+				for (std::size_t i = 0; prefix[i] != '\0'; ++i)
+					if (i == text.size() || text[i] != static_cast<CharType>(prefix[i]))
+						return false;
+				return true;
+			};
+			if (!startsWith(uri, "data:"))
+				return std::nullopt;
+			const std::size_t comma = uri.find(static_cast<CharType>(','));
+			if (comma == StringViewType::npos || comma < 7 || !startsWith(uri.substr(comma - 7), ";base64"))
+				return std::nullopt;
+			return uri.substr(comma + 1);
+		}
+
+		template <class CharTy>
+		inline void Base64<CharTy>::_error(std::size_t pos, const char* msg) {
+			throw std::runtime_error("[Base64] pos:" + std::to_string(pos + 1) + " " + msg);
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_Base64_hpp */
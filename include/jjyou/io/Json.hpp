@@ -11,10 +11,14 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <string_view>
 #include <filesystem>
+#include <memory>
 #include <vector>
 #include <stack>
+#include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <variant>
 #include <optional>
 #include <iterator>
@@ -22,6 +26,24 @@
 #include <cmath>
 #include <locale>
 #include <codecvt>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <limits>
+#include <bit>
+#include <functional>
+#include <span>
+#include <atomic>
+#include <thread>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#include "MappedFile.hpp"
+#include "JsonObject.hpp"
+#include "JsonSerializer.hpp"
+#include "JsonBinary.hpp"
 
 namespace jjyou {
 
@@ -31,13 +53,19 @@ namespace jjyou {
 		 *                    Forward declarations
 		 *============================================================*/
 		enum class JsonType;
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> class Json;
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> class JsonIterator;
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> class JsonConstIterator;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class Json;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonIterator;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonConstIterator;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonDomBuilder;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class HashedJson;
 		template <class StringTy> class JsonInputAdapter;
+		class JsonStructuralIndex;
 		enum class JsonTokenType;
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> class JsonToken;
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> class JsonLexer;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonToken;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonLexer;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonView;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonPushParser;
+		template <class JsonTy> class JsonBinder;
 		/*============================================================
 		 *                 End of forward declarations
 		 *============================================================*/
@@ -64,29 +92,119 @@ namespace jjyou {
 			Object = 6
 		};
 
+		/** @brief	Allocator of type `T` in the same family as the allocator of `StringTy`.
+		  *
+		  * Json containers allocate through this allocator, so that a Json whose `StringTy`
+		  * is e.g. `std::pmr::string` also stores its arrays and objects in `std::pmr` containers.
+		  * String types without `allocator_type` fall back to `std::allocator<T>`.
+		  */
+		template <class StringTy, class T>
+		struct JsonRebindAllocator {
+			using type = std::allocator<T>;
+		};
+		template <class StringTy, class T> requires requires { typename StringTy::allocator_type; }
+		struct JsonRebindAllocator<StringTy, T> {
+			using type = typename std::allocator_traits<typename StringTy::allocator_type>::template rebind_alloc<T>;
+		};
+
+		/** @brief	Whether `StringTy` is a `std::basic_string_view`.
+		  *
+		  * A Json with such a string type does not own its strings. See `Json::parse(src, arena)`.
+		  */
+		template <class StringTy>
+		inline constexpr bool JsonIsStringView = false;
+		template <class CharT, class Traits>
+		inline constexpr bool JsonIsStringView<std::basic_string_view<CharT, Traits>> = true;
+
+		/** @brief	String type that owns its characters, used for text produced by Json, e.g. by `Json::dump`.
+		  *
+		  * It is `StringTy` itself, except that `std::basic_string_view` becomes `std::basic_string`.
+		  */
+		template <class StringTy>
+		struct JsonOwningString {
+			using type = StringTy;
+		};
+		template <class CharT, class Traits>
+		struct JsonOwningString<std::basic_string_view<CharT, Traits>> {
+			using type = std::basic_string<CharT, Traits>;
+		};
+
+		/***********************************************************************
+		 * @class	JsonStringArena
+		 * @brief	Storage of the strings of a Json whose `StringTy` is a string view.
+		 *
+		 * Strings are copied into large blocks, which are only freed when the
+		 * arena is cleared or destroyed. Views returned by `store` stay valid
+		 * until then, also when the arena is moved.
+		 ***********************************************************************/
+		template <class CharT>
+		class JsonStringArena {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using CharType = CharT;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Construct an empty arena that allocates blocks of `blockSize` characters.
+			  *			Longer strings get a block of their own.
+			  */
+			explicit JsonStringArena(std::size_t blockSize = 4096) : _blockSize(std::max<std::size_t>(blockSize, 1)) {}
+
+			JsonStringArena(const JsonStringArena&) = delete;
+			JsonStringArena(JsonStringArena&&) = default;
+			JsonStringArena& operator=(const JsonStringArena&) = delete;
+			JsonStringArena& operator=(JsonStringArena&&) = default;
+
+			/** @brief	Copy `string` into the arena.
+			  * @return	A view of the copy.
+			  */
+			StringViewType store(StringViewType string);
+
+			/** @brief	Free all strings. Views returned by `store` become dangling.
+			  */
+			void clear(void);
+
+			/** @brief	Get the number of characters stored.
+			  */
+			std::size_t size(void) const { return this->_size; }
+
+		private:
+
+			std::size_t _blockSize;
+			std::vector<std::unique_ptr<CharType[]>> _blocks{};
+			CharType* _curr = nullptr;
+			std::size_t _left = 0;
+			std::size_t _size = 0;
+
+		};
+
 		/** @brief	Helper function to print Json to output stream.
 		  */
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline std::basic_ostream<typename StringTy::value_type>& operator<<(std::basic_ostream<typename StringTy::value_type>& out, const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::basic_ostream<typename StringTy::value_type>& operator<<(std::basic_ostream<typename StringTy::value_type>& out, const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json);
 
 		/** @brief	Helper function to print Json to a string.
 		  * @note	This function is different from `Json::operator StringType(void) const`.
 		  */
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline StringTy to_string(const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonOwningString<StringTy>::type to_string(const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json);
 
 		/** @brief	Compare two Json containers.
 		  * @return	`true` the two Json containers are equal (have the same structure and
 		  *			the elements in one container are equal to their corresponding ones in the other container).
 		  */
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		bool operator==(const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		bool operator==(const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json2);
 
 		/** @brief	Compare two Json containers.
 		  * @return	`true` the two Json containers are unequal.
 		  */
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		bool operator!=(const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		bool operator!=(const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json2);
 
 		/***********************************************************************
 		 * @class	Json
@@ -99,12 +217,26 @@ namespace jjyou {
 		 *						 - strict weak orderable (i.e. StringTy::operator< is properly implemented.)
 		 *						 - defines `value_type` as its character type
 		 * @tparam	BoolTy		The boolean type. Default is `bool`.
+		 * @tparam	ObjectPolicyTy	The storage of objects. Default is `JsonMapObject` (`std::map`).
+		 *						`JsonFlatObject` stores members in a sorted vector, `JsonOrderedObject`
+		 *						keeps them in document order with a hash index (see `JsonObject.hpp`).
+		 *
+		 * Arrays and objects use the allocator family of `StringTy` (see `JsonRebindAllocator`).
+		 * With `std::pmr::string`, a whole document can be parsed into one memory resource,
+		 * e.g. a `std::pmr::monotonic_buffer_resource`, with `Json::parse(src, &resource)`.
+		 * Copies of such containers use the default memory resource, moves keep the resource.
+		 *
+		 * With `StringTy = std::string_view`, strings and keys are not owned. `Json::parse(src, arena)`
+		 * then references the strings of a caller-owned buffer in place and copies only
+		 * strings with escape sequences into a `JsonStringArena`. Copies of such a Json are
+		 * shallow, and new strings must be given storage by the caller, e.g. with `arena.store`.
 		 ***********************************************************************/
 		template <
 			class IntegerTy = int,
 			class FloatingTy = float,
 			class StringTy = std::string,
-			class BoolTy = bool
+			class BoolTy = bool,
+			class ObjectPolicyTy = JsonMapObject
 		>
 		class Json {
 
@@ -119,24 +251,237 @@ namespace jjyou {
 			using const_reference = const value_type&;
 			using pointer = value_type*;
 			using const_pointer = const value_type*;
-			using iterator = JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>;
-			using const_iterator = JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>;
+			using iterator = JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using const_iterator = JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
 			using IntegerType = IntegerTy;
 			using FloatingType = FloatingTy;
 			using StringType = StringTy;
 			using BoolType = BoolTy;
-			using ArrayType = std::vector<Json>;
-			using ObjectType = std::map<StringTy, Json>;
+			using AllocatorType = typename JsonRebindAllocator<StringTy, Json>::type;
+			using ArrayType = std::vector<Json, typename JsonRebindAllocator<StringTy, Json>::type>;
+			using IntegerArrayType = std::vector<IntegerType, typename JsonRebindAllocator<StringTy, IntegerType>::type>;
+			using FloatingArrayType = std::vector<FloatingType, typename JsonRebindAllocator<StringTy, FloatingType>::type>;
+			using ObjectType = typename ObjectPolicyTy::template type<StringTy, Json, AllocatorType>;
 			using CharType = StringType::value_type;
+			using DumpOptions = JsonDumpOptions;
 			//@}
 
 		public:
 
 			/** @brief	Parse Json.
+			  *
+			  * `src` can be an input stream, a file path, or a contiguous buffer (`StringType`,
+			  * `std::basic_string_view<CharType>`, `const CharType*`, `std::vector<CharType>`).
+			  * Contiguous buffers are lexed directly from memory. Buffers passed by rvalue are
+			  * moved into the parser, otherwise they must stay alive during parsing.
+			  * Regular files are memory-mapped read-only (see `MappedFile`).
 			  */
 			template <class T>
 			static Json parse(T&& src);
 
+			/** @brief	Options that control how Json is parsed.
+			  */
+			struct ParseOptions {
+
+				/** @brief	Use the two-stage parser.
+				  *
+				  * Stage 1 finds the positions of all structural characters, quotes and
+				  * token starts with SIMD instructions (SSE2/AVX2, with a scalar fallback)
+				  * and stores them in an index. Stage 2 lexes the tokens at the indexed
+				  * positions and skips the whitespace in between without scanning it.
+				  * The result and the error messages are the same as the default parser.
+				  * Only contiguous inputs with 1-byte character types use the index.
+				  */
+				bool structuralIndex = false;
+
+				/** @brief	Keep numbers as text and convert them on first access.
+				  *
+				  * Integers and floating points are stored as their text in the document and
+				  * converted when they are first read, e.g. by `operator IntegerType()`. The
+				  * converted value replaces the text. Numbers that are never read are written
+				  * back unchanged by `dump`. `type()` is known without converting.
+				  * The text is stored inside the container, without allocation. Numbers that
+				  * are too long for it (more than 31 characters for `std::string`), numbers in
+				  * non-standard syntax (e.g. "+1" or ".5") and integers that may not fit
+				  * `IntegerType` are still converted during parsing.
+				  * @note	The first read of a lazy number modifies the container, so concurrent
+				  *			first reads of the same number are not thread-safe.
+				  */
+				bool lazyNumbers = false;
+
+				/** @brief	Number of threads for parsing a large top-level array.
+				  *
+				  * If the input is a contiguous buffer of at least `parallelThreshold` characters
+				  * holding an array, a pre-scan splits the array at top-level commas into chunks
+				  * of elements. The chunks are parsed on this many threads and their elements are
+				  * moved into the result in order, so the result is the same as the sequential
+				  * parse. If any chunk fails to parse, the whole input is parsed again sequentially
+				  * to report the error exactly as the sequential parser does.
+				  * 1 parses sequentially, 0 means `std::thread::hardware_concurrency()`.
+				  * Only stateless allocators, such as `std::allocator`, are shared by threads.
+				  * Inputs parsed with other allocators (e.g. `std::pmr` memory resources, which
+				  * are usually not thread-safe) or into a `JsonStringArena` are parsed sequentially.
+				  */
+				std::size_t threads = 1;
+
+				/** @brief	Minimum number of characters of the input to parse it on several threads.
+				  */
+				std::size_t parallelThreshold = std::size_t(1) << 22;
+
+				/** @brief	Maximum nesting depth of arrays and objects.
+				  *
+				  * The top-level array or object has depth 1. Deeper input is rejected with
+				  * an error. Parsing, serialization, comparison and destruction use explicit
+				  * stacks, so the limit is not needed to protect the call stack. It bounds the
+				  * work on untrusted input and protects functions that still recurse over the
+				  * document, such as `hash()`, `diff()` and copying.
+				  * `std::numeric_limits<std::size_t>::max()` disables the limit.
+				  */
+				std::size_t maxDepth = 1024;
+
+				/** @brief	Store arrays of numbers packed.
+				  *
+				  * A non-empty array whose elements are all integers, or all floating points, is stored
+				  * as one contiguous `IntegerArrayType` or `FloatingArrayType` instead of one Json per
+				  * element, which takes several times less memory. `type()` is still `JsonType::Array`.
+				  * `integers()` and `floatings()` give the numbers as a `std::span` without copying,
+				  * e.g. to map them with `Eigen::Map` or upload them as a vertex buffer, and
+				  * `operator std::vector<T>() &&` moves them out if `T` is the stored type.
+				  * `size()`, `dump`, `operator==`, `hash()`, `diff`, conversions and `element()` read
+				  * packed arrays directly. Non-const accesses to the elements (e.g. `operator[]`, `array()`
+				  * or iterators) convert the array back to one Json per element, as `unpack()` does.
+				  * Const accesses (e.g. `operator[] const`, `array() const` or const iterators) keep the
+				  * numbers and the spans to them, and read one Json per element built next to the numbers
+				  * by the first such access. Arrays that mix integers and floating points are not packed,
+				  * so that they are written back unchanged. Numbers of packed arrays are converted while
+				  * parsing, even if `lazyNumbers` is set.
+				  * @note	Const accesses are thread-safe. The elements they build take as much memory
+				  *			as an unpacked array, until the array is modified or unpacked, so prefer
+				  *			`integers()`, `floatings()` or `element()` to read large packed arrays.
+				  */
+				bool packNumbers = false;
+
+				/** @brief	Keys whose arrays of numbers are packed, as with `packNumbers`.
+				  *
+				  * Use it to pack only the large arrays, e.g. `{ "positions", "normals" }`, when
+				  * `packNumbers` is false. The keys are matched at any depth.
+				  */
+				std::vector<typename JsonOwningString<StringType>::type> packedKeys{};
+
+			};
+
+			/** @brief	Parse Json with the given options.
+			  */
+			template <class T>
+			static Json parse(T&& src, const ParseOptions& options);
+
+			/** @brief	Parse Json, allocating all strings, arrays and objects through `allocator`.
+			  *
+			  * For example, with `StringTy = std::pmr::string`, `Json::parse(src, &arena)` builds
+			  * the whole document in the memory resource `arena`. Destroying the document still
+			  * visits every node, but deallocation becomes a no-op for monotonic resources.
+			  */
+			template <class T>
+			static Json parse(T&& src, const AllocatorType& allocator);
+
+			/** @brief	Parse Json with the given options, allocating through `allocator`.
+			  */
+			template <class T>
+			static Json parse(T&& src, const ParseOptions& options, const AllocatorType& allocator);
+
+			/** @brief	Parse Json into a Json whose `StringTy` is a string view.
+			  *
+			  * If `src` is a caller-owned contiguous buffer (not an rvalue and not a file path),
+			  * strings and keys without escape sequences are views into `src`. All other strings
+			  * are copied into `arena`. `src` and `arena` must outlive the result.
+			  */
+			template <class T>
+			static Json parse(T&& src, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy>;
+
+			/** @brief	Parse Json with the given options into a Json whose `StringTy` is a string view.
+			  */
+			template <class T>
+			static Json parse(T&& src, const ParseOptions& options, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy>;
+
+			/** @brief	Parse Json as a stream of events without building a Json container.
+			  *
+			  * `src` is the same as in `parse`. The grammar and the error messages are the same
+			  * as `parse`, which builds its result with `JsonDomBuilder`, one such handler.
+			  * `handler` must provide these member functions, called in document order:
+			  *  - `onNull()`, `onInteger(IntegerType)`, `onFloating(FloatingType)`, `onBool(BoolType)`
+			  *  - `onString(std::basic_string_view<CharType>)`
+			  *  - `onStartArray()`, `onEndArray()`
+			  *  - `onStartObject()`, `onKey(std::basic_string_view<CharType>)`, `onEndObject()`
+			  *
+			  * Strings and keys of contiguous inputs without escape sequences are views into
+			  * the input. Other strings are views into a temporary buffer. In both cases the
+			  * view is only valid during the call. Memory usage does not depend on the size
+			  * of the document, only on its nesting depth.
+			  *
+			  * If `ParseOptions::lazyNumbers` is set and `handler` also provides `onRawInteger`
+			  * and `onRawFloating`, taking a `std::basic_string_view<CharType>`, numbers are
+			  * passed as their text instead of being converted.
+			  */
+			template <class T, class HandlerTy>
+			static void sax(T&& src, HandlerTy& handler);
+
+			/** @brief	Parse Json as a stream of events with the given options.
+			  */
+			template <class T, class HandlerTy>
+			static void sax(T&& src, HandlerTy& handler, const ParseOptions& options);
+
+			/** @brief	Pass the Json container to an event handler, in document order.
+			  *
+			  * `handler` gets the same events as in `sax`, e.g. a `JsonWriter` to write the
+			  * container as one value of a larger document. Handlers that also provide
+			  * `onStartArray(std::size_t)` and `onStartObject(std::size_t)` get the sizes of the
+			  * containers, and handlers that provide `onRawInteger` and `onRawFloating` get lazy
+			  * numbers (see `ParseOptions::lazyNumbers`) as their text. The container is not
+			  * modified, and the call stack does not grow with its nesting depth.
+			  */
+			template <class HandlerTy>
+			void emit(HandlerTy& handler) const {
+				this->_emit(handler);
+			}
+
+			/** @brief	Serialize the Json container to a string.
+			  *
+			  * With the default options, the result is the same as `to_string(json)`.
+			  * See `JsonSerializer` for the number format.
+			  */
+			typename JsonOwningString<StringType>::type dump(const DumpOptions& options = DumpOptions()) const;
+
+			/** @brief	Serialize the Json container into a sink.
+			  *
+			  * `sink` is called as `sink(const CharType* data, std::size_t size)` with
+			  * consecutive pieces of the output, e.g. to append them to a buffer or a file.
+			  */
+			template <class SinkTy> requires std::is_invocable_v<SinkTy&, const typename StringTy::value_type*, std::size_t>
+			void dump(SinkTy&& sink, const DumpOptions& options = DumpOptions()) const;
+
+			/** @name	Binary encodings.
+			  *
+			  * `toCBOR` and `toMsgPack` encode the container with `JsonBinaryWriter`, into a byte
+			  * vector or into a sink called as `sink(const std::uint8_t* data, std::size_t size)`.
+			  * `fromCBOR` and `fromMsgPack` decode exactly one value with `JsonBinaryReader`,
+			  * and throw std::runtime_error on malformed data, on trailing bytes, and on nesting
+			  * deeper than the default `ParseOptions::maxDepth`. With a
+			  * `JsonStringArena` (see `parse`), strings are views into `data` without copying.
+			  * Only 1-byte character types are supported, as strings are stored as UTF-8.
+			  */
+			//@{
+			std::vector<std::uint8_t> toCBOR(void) const;
+			template <class SinkTy> requires std::is_invocable_v<SinkTy&, const std::uint8_t*, std::size_t>
+			void toCBOR(SinkTy&& sink) const;
+			std::vector<std::uint8_t> toMsgPack(void) const;
+			template <class SinkTy> requires std::is_invocable_v<SinkTy&, const std::uint8_t*, std::size_t>
+			void toMsgPack(SinkTy&& sink) const;
+			static Json fromCBOR(std::span<const std::uint8_t> data, const AllocatorType& allocator = AllocatorType());
+			static Json fromCBOR(std::span<const std::uint8_t> data, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy>;
+			static Json fromMsgPack(std::span<const std::uint8_t> data, const AllocatorType& allocator = AllocatorType());
+			static Json fromMsgPack(std::span<const std::uint8_t> data, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy>;
+			//@}
+
 			/** @brief	Default constructor. Create a "null" json container.
 			  */
 			Json(void) : _type(JsonType::Null), _dummy{} {}
@@ -206,6 +551,13 @@ namespace jjyou {
 				this->_create(type);
 			}
 
+			/** @brief	Construct a json container of the specified type with default value.
+			  *			Strings, arrays and objects allocate through `allocator`.
+			  */
+			Json(JsonType type, const AllocatorType& allocator) : _type(JsonType::Null), _dummy{} {
+				this->_create(type, allocator);
+			}
+
 			/** @brief	Copy constructor.
 			  */
 			Json(const Json& json) : _type(JsonType::Null), _dummy{} {
@@ -214,7 +566,7 @@ namespace jjyou {
 
 			/** @brief	Move constructor.
 			  */
-			Json(Json&& json) : _type(JsonType::Null), _dummy{} {
+			Json(Json&& json) noexcept : _type(JsonType::Null), _dummy{} {
 				this->_assign(std::move(json));
 			}
 
@@ -230,7 +582,7 @@ namespace jjyou {
 
 			/** @brief	Move assignment.
 			  */
-			Json& operator=(Json&& json) {
+			Json& operator=(Json&& json) noexcept {
 				if (this != &json) {
 					this->_reset();
 					this->_assign(std::move(json));
@@ -300,7 +652,13 @@ namespace jjyou {
 			  *			This function is valid only if the Json's type is `JsonType::String`.
 			  *			Otherwise, an exception of type std::out_of_range is thrown.
 			  */
-			explicit operator StringType(void) const;
+			explicit operator StringType(void) const&;
+
+			/** @brief	Move the string out of an expiring Json.
+			  *
+			  *			The Json is left in a valid but unspecified state.
+			  */
+			explicit operator StringType(void) &&;
 
 			/** @brief	Convert the Json to a bool.
 			  *
@@ -318,7 +676,16 @@ namespace jjyou {
 			  *			Otherwise, an exception of type std::out_of_range is thrown.
 			  */
 			template <class T>
-			explicit operator std::vector<T>(void) const;
+			explicit operator std::vector<T>(void) const&;
+
+			/** @brief	Convert an expiring Json to a std::vector, moving the elements.
+			  *
+			  *			Each element is converted to `T` from an rvalue, so strings, arrays
+			  *			and objects are moved instead of copied. The Json is left in a valid
+			  *			but unspecified state.
+			  */
+			template <class T>
+			explicit operator std::vector<T>(void) &&;
 
 			/** @brief	Convert the Json to a std::map.
 			  *
@@ -328,15 +695,25 @@ namespace jjyou {
 			  *			Otherwise, an exception of type std::out_of_range is thrown.
 			  */
 			template <class T>
-			explicit operator std::map<StringType, T>(void) const;
+			explicit operator std::map<StringType, T>(void) const&;
+
+			/** @brief	Convert an expiring Json to a std::map, moving the values.
+			  *
+			  *			Keys are also moved if the object policy allows it (see `JsonFlatObject`
+			  *			and `JsonOrderedObject`). The Json is left in a valid but unspecified state.
+			  */
+			template <class T>
+			explicit operator std::map<StringType, T>(void) &&;
 
 			/** @brief	Get the integer stored in the container. If the type does not match,
 			  *			the behavior is undefined.
 			  */
 			IntegerType& integer(void) {
+				this->_decode();
 				return this->_integer;
 			}
 			const IntegerType& integer(void) const {
+				this->_decode();
 				return this->_integer;
 			}
 
@@ -344,21 +721,26 @@ namespace jjyou {
 			  *			the behavior is undefined.
 			  */
 			FloatingType& floating(void) {
+				this->_decode();
 				return this->_floating;
 			}
 			const FloatingType& floating(void) const {
+				this->_decode();
 				return this->_floating;
 			}
 
 			/** @brief	Get the string stored in the container. If the type does not match,
 			  *			the behavior is undefined.
 			  */
-			StringType& string(void) {
+			StringType& string(void) & {
 				return this->_string;
 			}
-			const StringType& string(void) const {
+			const StringType& string(void) const& {
 				return this->_string;
 			}
+			StringType string(void) && {
+				return std::move(this->_string);
+			}
 
 			/** @brief	Get the bool stored in the container. If the type does not match,
 			  *			the behavior is undefined.
@@ -372,23 +754,108 @@ namespace jjyou {
 
 			/** @brief	Get the array stored in the container. If the type does not match,
 			  *			the behavior is undefined.
+			  *
+			  * The non-const overloads unpack a packed array (see `ParseOptions::packNumbers`).
+			  * @note	The const overload keeps a packed array, and returns the elements built
+			  *			next to its numbers.
 			  */
-			ArrayType& array(void) {
+			ArrayType& array(void) & {
+				this->_unpack();
 				return this->_array;
 			}
-			const ArrayType& array(void) const {
-				return this->_array;
+			const ArrayType& array(void) const& {
+				return this->_elements();
+			}
+			ArrayType array(void) && {
+				this->_unpack();
+				return std::move(this->_array);
+			}
+
+			/** @brief	Get the type of the numbers of a packed array (see `ParseOptions::packNumbers`).
+			  * @return	`JsonType::Integer` or `JsonType::Floating` if the Json container is a packed
+			  *			array, `JsonType::Null` otherwise.
+			  */
+			JsonType packedType(void) const {
+				return (this->_packed == _Packing::Integer) ? JsonType::Integer : (this->_packed == _Packing::Floating) ? JsonType::Floating : JsonType::Null;
+			}
+
+			/** @brief	Pack an array of numbers (see `ParseOptions::packNumbers`).
+			  *
+			  * This function is valid only if the Json's type is `JsonType::Array`.
+			  * Otherwise, an exception of type std::out_of_range is thrown.
+			  * @return	`true` if the array is packed, i.e. it is not empty and its elements
+			  *			are all integers or all floating points.
+			  */
+			bool pack(void);
+
+			/** @brief	Convert a packed array back to one Json per element.
+			  *
+			  * It does nothing if the Json container is not a packed array. The elements already
+			  * built by const accesses are reused.
+			  * @note	It invalidates the spans returned by `integers()` and `floatings()`.
+			  */
+			void unpack(void) {
+				this->_unpack();
+			}
+
+			/** @brief	Get a copy of the value at a given position, with bounds checking.
+			  *
+			  * Unlike `at(size_type) const`, it reads packed arrays without building their elements.
+			  * This function is valid only if the Json's type is `JsonType::Array`.
+			  * Otherwise, an exception of type std::out_of_range is thrown.
+			  */
+			Json element(size_type pos) const;
+
+			/** @brief	Get the numbers of a packed array of integers without converting them.
+			  *
+			  * This function is valid only if `packedType()` is `JsonType::Integer`.
+			  * Otherwise, an exception of type std::out_of_range is thrown.
+			  * The non-const overload drops the elements built by const accesses, since the
+			  * numbers may be modified through the span. Do not write through it after a later
+			  * const access to the elements.
+			  */
+			std::span<IntegerType> integers(void) {
+				if (this->_packed != _Packing::Integer)
+					throw std::out_of_range("`std::span<IntegerType> Json::integers()` is valid only if the Json container is a packed array of integers.");
+				this->_integers.reset();
+				return std::span<IntegerType>(this->_integers);
+			}
+			std::span<const IntegerType> integers(void) const {
+				if (this->_packed != _Packing::Integer)
+					throw std::out_of_range("`std::span<const IntegerType> Json::integers() const` is valid only if the Json container is a packed array of integers.");
+				return std::span<const IntegerType>(this->_integers);
+			}
+
+			/** @brief	Get the numbers of a packed array of floating points without converting them.
+			  *
+			  * This function is valid only if `packedType()` is `JsonType::Floating`.
+			  * Otherwise, an exception of type std::out_of_range is thrown.
+			  * The non-const overload drops the elements built by const accesses, as `integers()`.
+			  */
+			std::span<FloatingType> floatings(void) {
+				if (this->_packed != _Packing::Floating)
+					throw std::out_of_range("`std::span<FloatingType> Json::floatings()` is valid only if the Json container is a packed array of floating points.");
+				this->_floatings.reset();
+				return std::span<FloatingType>(this->_floatings);
+			}
+			std::span<const FloatingType> floatings(void) const {
+				if (this->_packed != _Packing::Floating)
+					throw std::out_of_range("`std::span<const FloatingType> Json::floatings() const` is valid only if the Json container is a packed array of floating points.");
+				return std::span<const FloatingType>(this->_floatings);
 			}
 
 			/** @brief	Get the array stored in the container. If the type does not match,
 			  *			the behavior is undefined.
 			  */
-			ObjectType& object(void) {
+			ObjectType& object(void) & {
 				return this->_object;
 			}
-			const ObjectType& object(void) const {
+			const ObjectType& object(void) const& {
 				return this->_object;
 			}
+			ObjectType object(void) && {
+				return std::move(this->_object);
+			}
 
 			/** @brief	Get the reference to the value at a given position.
 			  * 
@@ -397,6 +864,7 @@ namespace jjyou {
 			  * @return	The reference to the value at a given position.
 			  */
 			reference operator[](size_type pos) {
+				this->_unpack();
 				return this->_array[pos];
 			}
 
@@ -404,10 +872,11 @@ namespace jjyou {
 			  *
 			  * The index starts from 0. This function is valid only if the Json's
 			  * type is `JsonType::Array`. Otherwise, the behavior is undefined.
+			  * @note	It keeps a packed array, and reads the elements built next to its numbers.
 			  * @return	The const reference to the value at a given position.
 			  */
 			const_reference operator[](size_type pos) const {
-				return this->_array[pos];
+				return this->_elements()[pos];
 			}
 
 			/** @brief	Get the reference to the value that is mapped to the given key,
@@ -449,6 +918,7 @@ namespace jjyou {
 			reference at(size_type pos) {
 				if (this->_type != JsonType::Array)
 					throw std::out_of_range("`Json& Json::at(size_type)` is valid only if the Json container is an array.");
+				this->_unpack();
 				return this->_array.at(pos);
 			}
 
@@ -456,12 +926,13 @@ namespace jjyou {
 			  *
 			  * The index starts from 0. This function is valid only if the Json's
 			  * type is `JsonType::Array`. Otherwise, an exception of type std::out_of_range is thrown.
+			  * @note	It keeps a packed array, and reads the elements built next to its numbers.
 			  * @return	The const reference to the value at a given position.
 			  */
 			const_reference at(size_type pos) const {
 				if (this->_type != JsonType::Array)
 					throw std::out_of_range("`const Json& Json::at(size_type) const` is valid only if the Json container is an array.");
-				return this->_array.at(pos);
+				return this->_elements().at(pos);
 			}
 
 			/** @brief	Get the reference to the value that is mapped to the given key, with bounds checking.
@@ -500,6 +971,10 @@ namespace jjyou {
 
 			/** @name	Iterator-related methods.
 			  * @brief	Get the iterator pointing to the specified position.
+			  *
+			  * The non-const overloads unpack a packed array (see `ParseOptions::packNumbers`).
+			  * @note	The const overloads keep a packed array, and iterate over the elements
+			  *			built next to its numbers.
 			  */
 			//@{
 			iterator begin(void);
@@ -528,36 +1003,146 @@ namespace jjyou {
 			  */
 			const_iterator find(const StringType& key) const;
 
-			friend std::basic_ostream<CharType>& operator<< <IntegerTy, FloatingTy, StringTy, BoolTy>(std::basic_ostream<CharType>& out, const Json& json);
+			/** @brief	Move the Json container out, leaving null in its place.
+			  *
+			  * Use it to steal a subtree from its parent without copying it, e.g.
+			  * `Json records = document["records"].take();`.
+			  */
+			Json take(void) {
+				Json res(std::move(*this));
+				return res;
+			}
+
+			/** @brief	Remove the value that is mapped to the given key and return it, without copying it.
+			  *
+			  * This function is valid only if the Json's type is `JsonType::Object`, and the Json
+			  * contains the given key. Otherwise, an exception of type std::out_of_range is thrown.
+			  */
+			Json extract(const StringType& key);
+			template <class T>
+			Json extract(const T* key) requires (std::is_same_v<T, CharType>) {
+				return this->extract(StringType(key));
+			}
+
+			/** @brief	Get the structural hash of the Json container.
+			  *
+			  * Equal containers (see `operator==`) have equal hashes. The hash of an object does
+			  * not depend on the order of its members.
+			  *
+			  * The hash is not cached in the container, so every call visits the whole container.
+			  * Wrap the container in `HashedJson` to cache it, e.g. to compare or deduplicate
+			  * snapshots.
+			  */
+			std::uint64_t hash(void) const;
+
+			/** @brief	Compute a JSON Patch (RFC 6902) that transforms `source` into `target`.
+			  *
+			  * The patch is an array of "add", "remove" and "replace" operations. The hashes of
+			  * all subtrees of `source` and `target` are computed once per call. Subtrees with
+			  * different hashes are diffed without comparing them, and subtrees with equal hashes
+			  * are confirmed equal with `operator==` and skipped, so diffing snapshots that share
+			  * most of their content only emits and copies the changed parts.
+			  * Objects are compared member by member. Arrays are compared element by element
+			  * after skipping their common prefix and suffix, so that inserting or removing
+			  * elements in one place gives "add" or "remove" operations for these elements only.
+			  */
+			static Json diff(const Json& source, const Json& target) requires (!JsonIsStringView<StringTy>);
 
-			friend StringTy to_string<IntegerTy, FloatingTy, StringTy, BoolTy>(const Json& json);
+			friend std::basic_ostream<CharType>& operator<< <IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(std::basic_ostream<CharType>& out, const Json& json);
+
+			friend typename JsonOwningString<StringTy>::type to_string<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const Json& json);
 			
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const Json& json1, const Json& json2);
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const Json& json1, const Json& json2);
 			
-			friend bool operator!=<IntegerTy, FloatingTy, StringTy, BoolTy>(const Json& json1, const Json& json2);
+			friend bool operator!=<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const Json& json1, const Json& json2);
 
-			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy>
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
 			friend class Json;
 
+			friend class JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+
+			template <class _JsonTy>
+			friend class JsonBinder;
+
 		private:
-			using InputAdapter = JsonInputAdapter<StringType>;
-			using Token = JsonToken<IntegerType, FloatingType, StringType, BoolType>;
-			using Lexer = JsonLexer<IntegerType, FloatingType, StringType, BoolType>;
+			using InputAdapter = JsonInputAdapter<typename JsonOwningString<StringType>::type>;
+			using Token = JsonToken<IntegerType, FloatingType, StringType, BoolType, ObjectPolicyTy>;
+			using Lexer = JsonLexer<IntegerType, FloatingType, StringType, BoolType, ObjectPolicyTy>;
+			using DomBuilder = JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
 			void _reset(void);
+			void _destroy(void);
+			void _teardown(void) noexcept;
+			static Json* _firstChild(Json& json);
+			static void _detach(Json& child, Json& pending) noexcept;
 			void _assign(const Json& json);
 			void _assign(Json&& json);
-			void _create(JsonType type);
-			void _print(std::basic_ostream<CharType>& out, int indent) const;
-			static Json _parse(Lexer& lexer);
+			void _create(JsonType type, const AllocatorType& allocator = AllocatorType());
+			static Json _lazyNumber(JsonType type, std::basic_string_view<CharType> text);
+			static Token _convertNumber(JsonType type, std::basic_string_view<CharType> text);
+			void _decode(void) const;
+			void _unpack(void);
+			ArrayType _packedElements(void) const;
+			const ArrayType& _elements(void) const;
+			template <class T>
+			std::vector<T> _packedVector(void) const;
+			template <class HandlerTy>
+			void _emit(HandlerTy& handler) const;
+			// Hashes of the arrays and objects visited by `_hash`, valid while they are not modified.
+			using _HashMemo = std::unordered_map<const Json*, std::uint64_t>;
+			static std::uint64_t _mix(std::uint64_t x);
+			std::uint64_t _hash(_HashMemo* memo) const;
+			static void _diff(const Json& source, const Json& target, typename JsonOwningString<StringTy>::type& path, ArrayType& patch, _HashMemo& memo);
+			template <class BuilderTy>
+			static Json _fromBinary(std::span<const std::uint8_t> data, JsonBinaryFormat format, BuilderTy& builder);
+			template <class T, class HandlerTy>
+			static void _sax(T&& src, HandlerTy& handler, const ParseOptions& options, const AllocatorType& allocator);
+			template <class HandlerTy>
+			static void _sax(InputAdapter& inputAdapter, HandlerTy& handler, const ParseOptions& options, const AllocatorType& allocator);
+			template <class HandlerTy>
+			static void _sax(Lexer& lexer, HandlerTy& handler);
+			static bool _parseParallel(const CharType* first, const CharType* last, const ParseOptions& options, const AllocatorType& allocator, Json& res);
 			JsonType _type;
+			// A lazy number (see `ParseOptions::lazyNumbers`) has the type Integer or
+			// Floating, but stores its text in `_raw` until `_decode` is called.
+			// The text is stored in place, so longer numbers are converted while parsing.
+			mutable bool _lazy = false;
+			// A packed array (see `ParseOptions::packNumbers`) has the type Array, but stores
+			// its numbers in `_integers` or `_floatings` until `_unpack` is called, which only
+			// non-const accessors do. Const accessors read the Json elements built next to the
+			// numbers by `_elements` instead.
+			enum class _Packing : unsigned char { None, Integer, Floating };
+			_Packing _packed = _Packing::None;
+			template <class NumberArrayTy>
+			struct _PackedNumbers : NumberArrayTy {
+				using NumberArrayTy::NumberArrayTy;
+				_PackedNumbers(NumberArrayTy&& numbers) : NumberArrayTy(std::move(numbers)) {}
+				// The elements are not copied, since the copy builds its own on demand.
+				_PackedNumbers(const _PackedNumbers& numbers) : NumberArrayTy(numbers) {}
+				_PackedNumbers(_PackedNumbers&& numbers) : NumberArrayTy(std::move(numbers)), elements(numbers.elements.exchange(nullptr)) {}
+				~_PackedNumbers(void) { delete this->elements.load(); }
+				// Drop the elements, before the numbers are modified.
+				void reset(void) { delete this->elements.exchange(nullptr); }
+				// Built once by the first const access and published atomically, then read-only.
+				mutable std::atomic<ArrayType*> elements = nullptr;
+			};
+			using _PackedIntegers = _PackedNumbers<IntegerArrayType>;
+			using _PackedFloatings = _PackedNumbers<FloatingArrayType>;
 			struct _Dummy {};
+			struct _Raw {
+				static constexpr std::size_t capacity = (std::max(sizeof(StringType), sizeof(ArrayType)) - 1) / sizeof(CharType);
+				CharType text[capacity];
+				unsigned char size;
+			};
 			union {
 				_Dummy _dummy;
-				IntegerType _integer;
-				FloatingType _floating;
+				mutable IntegerType _integer;
+				mutable FloatingType _floating;
+				mutable _Raw _raw;
 				StringType _string;
 				BoolType _bool;
 				ArrayType _array;
+				_PackedIntegers _integers;
+				_PackedFloatings _floatings;
 				ObjectType _object;
 			};
 
@@ -567,27 +1152,27 @@ namespace jjyou {
 		  * @note	DO NOT compare two iterators belonging to different Json instances.
 		  * @return	`true` if two iterators are considered to be equal.
 		  */
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator==(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator==(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator==(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator==(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator==(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator==(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator==(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator==(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
 
 		/** @brief	Compare two iterators.
 		  * @note	DO NOT compare two iterators belonging to different Json instances.
 		  * @return	`true` if two iterators are considered to be unequal.
 		  */
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator!=(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator!=(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator!=(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline bool operator!=(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator!=(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator!=(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator!=(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool operator!=(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
 
 		/***********************************************************************
 		 * @class	JsonIterator
@@ -597,7 +1182,8 @@ namespace jjyou {
 			class IntegerTy,
 			class FloatingTy,
 			class StringTy,
-			class BoolTy
+			class BoolTy,
+			class ObjectPolicyTy
 		>
 		class JsonIterator {
 
@@ -607,7 +1193,7 @@ namespace jjyou {
 			  */
 			//@{
 			using iterator_category = std::bidirectional_iterator_tag;
-			using value_type = Json<IntegerTy, FloatingTy, StringTy, BoolTy>;
+			using value_type = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
 			using difference_type = std::ptrdiff_t;
 			using pointer = value_type*;
 			using reference = value_type&;
@@ -622,7 +1208,7 @@ namespace jjyou {
 			~JsonIterator(void) = default;
 			JsonIterator& operator=(const JsonIterator&) = default;
 			JsonIterator& operator=(JsonIterator&&) = default;
-			operator JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>() const;
+			operator JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>() const;
 			//@}
 
 			/** @brief	Increment the iterator.
@@ -683,12 +1269,12 @@ namespace jjyou {
 			JsonIterator(pointer pJson, int pos) : pJson(pJson), pos(pos) {}
 			JsonIterator(pointer pJson, typename value_type::ObjectType::iterator objectIter) : pJson(pJson), objectIter(objectIter) {}
 			JsonIterator(pointer pJson, typename value_type::ArrayType::iterator arrayIter) : pJson(pJson), arrayIter(arrayIter) {}
-			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy>;
-			friend class JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>;
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
+			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend class JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
 
 		};
 
@@ -700,7 +1286,8 @@ namespace jjyou {
 			class IntegerTy,
 			class FloatingTy,
 			class StringTy,
-			class BoolTy
+			class BoolTy,
+			class ObjectPolicyTy
 		>
 		class JsonConstIterator {
 
@@ -710,7 +1297,7 @@ namespace jjyou {
 			  */
 			//@{
 			using iterator_category = std::bidirectional_iterator_tag;
-			using value_type = Json<IntegerTy, FloatingTy, StringTy, BoolTy>;
+			using value_type = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
 			using difference_type = std::ptrdiff_t;
 			using pointer = const value_type*;
 			using reference = const value_type&;
@@ -785,12 +1372,206 @@ namespace jjyou {
 			JsonConstIterator(pointer pJson, int pos) : pJson(pJson), pos(pos) {}
 			JsonConstIterator(pointer pJson, typename value_type::ObjectType::const_iterator objectIter) : pJson(pJson), objectIter(objectIter) {}
 			JsonConstIterator(pointer pJson, typename value_type::ArrayType::const_iterator arrayIter) : pJson(pJson), arrayIter(arrayIter) {}
-			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy>;
-			friend class JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>;
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
-			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2);
+			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend class JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+			friend bool operator==<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>(const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2);
+
+		};
+
+		/***********************************************************************
+		 * @class	JsonDomBuilder
+		 * @brief	Event handler of `Json::sax` that builds a Json container.
+		 *
+		 * `Json::parse` is `Json::sax` with this handler. Containers under
+		 * construction are kept on a stack and moved into their parent when
+		 * they are closed. As in `Json::parse`, the first occurrence of a
+		 * duplicate key wins.
+		 ***********************************************************************/
+		template <
+			class IntegerTy,
+			class FloatingTy,
+			class StringTy,
+			class BoolTy,
+			class ObjectPolicyTy
+		>
+		class JsonDomBuilder {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using DomType = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using AllocatorType = typename DomType::AllocatorType;
+			using CharType = typename DomType::CharType;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Construct a builder. Strings, arrays and objects allocate through `allocator`.
+			  */
+			JsonDomBuilder(const AllocatorType& allocator = AllocatorType()) : allocator(allocator) {
+				static_assert(!JsonIsStringView<StringTy>, "A Json whose StringTy is a string view must be built with a JsonStringArena.");
+			}
+
+			/** @brief	Construct a builder of a Json whose `StringTy` is a string view.
+			  *
+			  * Strings that lie in the buffer `[first, last)` are referenced in place.
+			  * Other strings are copied into `arena`.
+			  */
+			JsonDomBuilder(JsonStringArena<CharType>& arena, const CharType* first = nullptr, const CharType* last = nullptr, const AllocatorType& allocator = AllocatorType()) :
+				allocator(allocator), arena(&arena), first(first), last(last) {}
+
+			/** @name	Event handlers.
+			  */
+			//@{
+			void onNull(void) { this->_value(DomType()); }
+			void onInteger(IntegerTy integer) { this->_value(DomType(integer)); }
+			void onFloating(FloatingTy floating) { this->_value(DomType(floating)); }
+			void onRawInteger(StringViewType text) { this->_value(DomType::_lazyNumber(JsonType::Integer, text)); }
+			void onRawFloating(StringViewType text) { this->_value(DomType::_lazyNumber(JsonType::Floating, text)); }
+			void onBool(BoolTy boolean) { this->_value(DomType(boolean)); }
+			void onString(StringViewType string) { this->_value(DomType(this->_newString(string))); }
+			void onStartArray(void) { this->packing.push_back(this->_packable()); this->stack.emplace_back(JsonType::Array, this->allocator); }
+			void onEndArray(void) { this->packing.pop_back(); this->_close(); }
+			void onStartObject(void) { this->stack.emplace_back(JsonType::Object, this->allocator); }
+			void onKey(StringViewType key) { this->keys.push_back(this->_newString(key)); }
+			void onEndObject(void) { this->_close(); }
+			//@}
+
+			/** @brief	Pack arrays of numbers, all of them or only those under the given keys
+			  *			(see `Json::ParseOptions::packNumbers` and `Json::ParseOptions::packedKeys`).
+			  */
+			void pack(bool all, std::vector<typename JsonOwningString<StringTy>::type> keys = {}) {
+				this->packAll = all;
+				this->packedKeys = std::move(keys);
+			}
+
+			/** @brief	Get the built Json container, leaving null in the builder.
+			  */
+			DomType release(void) { return std::move(this->root); }
+
+		private:
+
+			AllocatorType allocator;
+			JsonStringArena<CharType>* arena = nullptr;
+			const CharType* first = nullptr;
+			const CharType* last = nullptr;
+			DomType root{};
+			std::vector<DomType> stack{};
+			std::vector<StringTy> keys{};
+			bool packAll = false;
+			std::vector<typename JsonOwningString<StringTy>::type> packedKeys{};
+			// Whether each array under construction may still be packed, innermost last.
+			std::vector<bool> packing{};
+			using StringAllocatorType = typename JsonRebindAllocator<StringTy, CharType>::type;
+			StringTy _newString(StringViewType string) const;
+			bool _packable(void) const;
+			bool _pack(DomType& array, DomType& json);
+			void _value(DomType&& json);
+			void _close(void);
+
+		};
+
+		/***********************************************************************
+		 * @class	HashedJson
+		 * @brief	A read-only Json container that caches its structural hash.
+		 *
+		 * `Json::hash` visits the whole container on every call, since a container
+		 * cannot know when its children are modified through references. This wrapper
+		 * only gives const access to its Json, so the hash computed on construction stays
+		 * valid. Modifications go through `modify`, which computes the hash again.
+		 *
+		 * `operator==` compares the cached hashes first, so different containers are
+		 * usually rejected in O(1), and equal hashes are confirmed with `Json`'s
+		 * `operator==`. With `std::hash<HashedJson>`, it deduplicates snapshots in
+		 * unordered containers without hashing them again.
+		 *
+		 * @tparam	IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy	Same as `Json`.
+		 ***********************************************************************/
+		template <
+			class IntegerTy = int,
+			class FloatingTy = float,
+			class StringTy = std::string,
+			class BoolTy = bool,
+			class ObjectPolicyTy = JsonMapObject
+		>
+		class HashedJson {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using DomType = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			//@}
+
+			/** @brief	Default constructor. Wrap a null Json.
+			  */
+			HashedJson(void) : _json(), _hash(this->_json.hash()) {}
+
+			/** @brief	Wrap a copy of a Json container and compute its hash.
+			  */
+			HashedJson(const DomType& json) : _json(json), _hash(this->_json.hash()) {}
+
+			/** @brief	Wrap a Json container and compute its hash.
+			  */
+			HashedJson(DomType&& json) : _json(std::move(json)), _hash(this->_json.hash()) {}
+
+			/** @brief	Get the wrapped Json container.
+			  */
+			const DomType& json(void) const { return this->_json; }
+			const DomType& operator*(void) const { return this->_json; }
+			const DomType* operator->(void) const { return &this->_json; }
+
+			/** @brief	Get the cached structural hash. It equals `json().hash()`.
+			  */
+			std::uint64_t hash(void) const { return this->_hash; }
+
+			/** @brief	Modify the wrapped Json container and compute its hash again.
+			  *
+			  * `f` is called as `f(DomType& json)`. The hash is computed again even if `f`
+			  * throws. References into the container must not be kept after `f` returns.
+			  */
+			template <class F>
+			void modify(F&& f) {
+				try {
+					f(this->_json);
+				}
+				catch (...) {
+					this->_hash = this->_json.hash();
+					throw;
+				}
+				this->_hash = this->_json.hash();
+			}
+
+			/** @brief	Move the wrapped Json container out, leaving null in its place.
+			  */
+			DomType take(void) {
+				DomType res(std::move(this->_json));
+				this->_json = DomType();
+				this->_hash = this->_json.hash();
+				return res;
+			}
+
+			/** @brief	Compare two containers, rejecting different hashes without visiting them.
+			  */
+			friend bool operator==(const HashedJson& json1, const HashedJson& json2) {
+				return json1._hash == json2._hash && json1._json == json2._json;
+			}
+
+			/** @brief	Compare two containers, rejecting different hashes without visiting them.
+			  */
+			friend bool operator!=(const HashedJson& json1, const HashedJson& json2) {
+				return !(json1 == json2);
+			}
+
+		private:
+
+			DomType _json;
+			std::uint64_t _hash;
 
 		};
 
@@ -809,6 +1590,41 @@ namespace jjyou {
 
 	namespace io {
 
+		template <class CharT>
+		inline typename JsonStringArena<CharT>::StringViewType JsonStringArena<CharT>::store(StringViewType string) {
+			if (string.empty())
+				return StringViewType();
+			CharType* dst = nullptr;
+			if (string.size() > this->_left) {
+				if (string.size() > this->_blockSize / 2) {
+					// Long strings get a block of their own, so that the rest of the current block is not wasted.
+					this->_blocks.push_back(std::make_unique_for_overwrite<CharType[]>(string.size()));
+					dst = this->_blocks.back().get();
+				}
+				else {
+					this->_blocks.push_back(std::make_unique_for_overwrite<CharType[]>(this->_blockSize));
+					this->_curr = this->_blocks.back().get();
+					this->_left = this->_blockSize;
+				}
+			}
+			if (dst == nullptr) {
+				dst = this->_curr;
+				this->_curr += string.size();
+				this->_left -= string.size();
+			}
+			std::copy(string.begin(), string.end(), dst);
+			this->_size += string.size();
+			return StringViewType(dst, string.size());
+		}
+
+		template <class CharT>
+		inline void JsonStringArena<CharT>::clear(void) {
+			this->_blocks.clear();
+			this->_curr = nullptr;
+			this->_left = 0;
+			this->_size = 0;
+		}
+
 		inline std::string to_string(JsonType type) {
 			switch (type) {
 			case JsonType::Null:
@@ -834,49 +1650,110 @@ namespace jjyou {
 			return (out << to_string(type));
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline std::basic_ostream<typename StringTy::value_type>& operator<<(std::basic_ostream<typename StringTy::value_type>& out, const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json) {
-			json._print(out, 0);
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::basic_ostream<typename StringTy::value_type>& operator<<(std::basic_ostream<typename StringTy::value_type>& out, const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json) {
+			json.dump([&out](const typename StringTy::value_type* data, std::size_t size) -> void {
+				out.write(data, static_cast<std::streamsize>(size));
+			});
 			return out;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline StringTy to_string(const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json) {
-			std::basic_stringstream<typename StringTy::value_type> sstream;
-			sstream << json;
-			return sstream.str();
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonOwningString<StringTy>::type to_string(const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json) {
+			return json.dump();
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		bool operator==(const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json2) {
-			if (json1._type != json2._type) return false;
-			switch (json1._type) {
-			case JsonType::Null:
-				return true;
-			case JsonType::Integer:
-				return json1._integer == json2._integer;
-			case JsonType::Floating:
-				return json1._floating == json2._floating;
-			case JsonType::String:
-				return json1._string == json2._string;
-			case JsonType::Bool:
-				return json1._bool == json2._bool;
-			case JsonType::Array:
-				return json1._array == json2._array;
-			case JsonType::Object:
-				return json1._object == json2._object;
-			default:
-				throw std::out_of_range("Invalid Json type.");
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		bool operator==(const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json2) {
+			using JsonTy = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			// Containers whose children are still to compare, instead of one call per level.
+			std::vector<std::pair<const JsonTy*, const JsonTy*>> pending{};
+			// Compare two values, except the children of containers.
+			auto visit = [&pending](const JsonTy& node1, const JsonTy& node2) -> bool {
+				if (node1._type != node2._type) return false;
+				node1._decode();
+				node2._decode();
+				switch (node1._type) {
+				case JsonType::Null:
+					return true;
+				case JsonType::Integer:
+					return node1._integer == node2._integer;
+				case JsonType::Floating:
+					return node1._floating == node2._floating;
+				case JsonType::String:
+					return node1._string == node2._string;
+				case JsonType::Bool:
+					return node1._bool == node2._bool;
+				case JsonType::Array:
+					if (node1.size() != node2.size()) return false;
+					if (node1._packed != JsonTy::_Packing::None && node2._packed != JsonTy::_Packing::None) {
+						if (node1._packed != node2._packed)
+							return node1.size() == 0;
+						if (node1._packed == JsonTy::_Packing::Integer)
+							return node1._integers == node2._integers;
+						return node1._floatings == node2._floatings;
+					}
+					if (node1.size() != 0)
+						pending.emplace_back(&node1, &node2);
+					return true;
+				case JsonType::Object:
+					if (node1._object.size() != node2._object.size()) return false;
+					if (!node1._object.empty())
+						pending.emplace_back(&node1, &node2);
+					return true;
+				default:
+					throw std::out_of_range("Invalid Json type.");
+				}
+			};
+			if (!visit(json1, json2))
+				return false;
+			while (!pending.empty()) {
+				const JsonTy& node1 = *pending.back().first;
+				const JsonTy& node2 = *pending.back().second;
+				pending.pop_back();
+				if (node1._type == JsonType::Array) {
+					if (node1._packed == JsonTy::_Packing::None && node2._packed == JsonTy::_Packing::None) {
+						for (std::size_t i = 0; i < node1._array.size(); ++i)
+							if (!visit(node1._array[i], node2._array[i]))
+								return false;
+					}
+					else {
+						// A packed array and a regular one: compare the numbers as Json values.
+						const JsonTy& packed = (node1._packed != JsonTy::_Packing::None) ? node1 : node2;
+						const JsonTy& regular = (node1._packed != JsonTy::_Packing::None) ? node2 : node1;
+						for (std::size_t i = 0; i < regular._array.size(); ++i) {
+							JsonTy number = (packed._packed == JsonTy::_Packing::Integer) ? JsonTy(packed._integers[i]) : JsonTy(packed._floatings[i]);
+							if (!visit(number, regular._array[i]))
+								return false;
+						}
+					}
+				}
+				else {
+					// Members are usually in the same order (always for sorted objects),
+					// otherwise they are looked up by key, as `JsonOrderedObject` does.
+					auto iter2 = node2._object.begin();
+					for (auto iter1 = node1._object.begin(); iter1 != node1._object.end(); ++iter1, ++iter2) {
+						if (iter2 == node2._object.end() || !(iter1->first == iter2->first)) {
+							iter2 = node2._object.find(iter1->first);
+							if (iter2 == node2._object.end())
+								return false;
+						}
+						if (!visit(iter1->second, iter2->second))
+							return false;
+					}
+				}
 			}
+			return true;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		bool operator!=(const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy>& json2) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		bool operator!=(const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json1, const Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& json2) {
 			return !(json1 == json2);
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy>::operator IntegerTy(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator IntegerTy(void) const {
+			this->_decode();
 			switch (this->_type) {
 			case JsonType::Integer:
 				return this->_integer;
@@ -894,8 +1771,9 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy>::operator FloatingTy(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator FloatingTy(void) const {
+			this->_decode();
 			switch (this->_type) {
 			case JsonType::Integer:
 				return static_cast<FloatingType>(this->_integer);
@@ -913,16 +1791,26 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy>::operator StringTy(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator StringTy(void) const& {
 			if (this->_type == JsonType::String)
 				return this->_string;
 			else
 				throw std::out_of_range("`Json::operator StringType() const` is valid only if the Json container is a string.");
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy>::operator BoolTy(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator StringTy(void) && {
+			if (this->_type == JsonType::String) {
+				return std::move(this->_string);
+			}
+			else
+				throw std::out_of_range("`Json::operator StringType() &&` is valid only if the Json container is a string.");
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator BoolTy(void) const {
+			this->_decode();
 			switch (this->_type) {
 			case JsonType::Integer:
 				return static_cast<BoolType>(this->_integer);
@@ -940,9 +1828,11 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> template <class T>
-		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy>::operator std::vector<T>(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator std::vector<T>(void) const& {
 			if (this->_type == JsonType::Array) {
+				if (this->_packed != _Packing::None)
+					return this->_packedVector<T>();
 				std::vector<T> res; res.reserve(this->_array.size());
 				for (const Json& v : this->_array)
 					res.emplace_back(v);
@@ -952,8 +1842,30 @@ namespace jjyou {
 				throw std::out_of_range("`Json::operator std::vector<T>() const` is valid only if the Json container is an array.");
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> template <class T>
-		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy>::operator std::map<StringTy, T>(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator std::vector<T>(void) && {
+			if (this->_type == JsonType::Array) {
+				if constexpr (std::is_same_v<std::vector<T>, IntegerArrayType>) {
+					if (this->_packed == _Packing::Integer)
+						return std::move(this->_integers);
+				}
+				if constexpr (std::is_same_v<std::vector<T>, FloatingArrayType>) {
+					if (this->_packed == _Packing::Floating)
+						return std::move(this->_floatings);
+				}
+				if (this->_packed != _Packing::None)
+					return this->_packedVector<T>();
+				std::vector<T> res; res.reserve(this->_array.size());
+				for (Json& v : this->_array)
+					res.emplace_back(std::move(v));
+				return res;
+			}
+			else
+				throw std::out_of_range("`Json::operator std::vector<T>() &&` is valid only if the Json container is an array.");
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator std::map<StringTy, T>(void) const& {
 			if (this->_type == JsonType::Object) {
 				std::map<StringType, T> res;
 				for (auto cIter = this->_object.cbegin(); cIter != this->_object.cend(); ++cIter)
@@ -964,8 +1876,28 @@ namespace jjyou {
 				throw std::out_of_range("`Json::operator std::map<StringType, T>() const` is valid only if the Json container is an object.");
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline std::size_t Json<IntegerTy, FloatingTy, StringTy, BoolTy>::size(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator std::map<StringTy, T>(void) && {
+			if (this->_type == JsonType::Object) {
+				std::map<StringType, T> res;
+				if constexpr (requires { this->_object.release(); }) {
+					// The keys are const through the iterators. Take the stored pairs to move them.
+					for (auto& member : this->_object.release())
+						res.emplace_hint(res.end(), std::move(member.first), std::move(member.second));
+				}
+				else {
+					for (auto iter = this->_object.begin(); iter != this->_object.end(); ++iter)
+						res.emplace_hint(res.end(), iter->first, std::move(iter->second));
+					this->_object.clear();
+				}
+				return res;
+			}
+			else
+				throw std::out_of_range("`Json::operator std::map<StringType, T>() &&` is valid only if the Json container is an object.");
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::size_t Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::size(void) const {
 			switch (this->_type) {
 			case JsonType::Null:
 				return 0ULL;
@@ -978,6 +1910,10 @@ namespace jjyou {
 			case JsonType::Bool:
 				return 1ULL;
 			case JsonType::Array:
+				if (this->_packed == _Packing::Integer)
+					return this->_integers.size();
+				if (this->_packed == _Packing::Floating)
+					return this->_floatings.size();
 				return this->_array.size();
 			case JsonType::Object:
 				return this->_object.size();
@@ -986,8 +1922,8 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::begin(void) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::begin(void) {
 			switch (this->_type) {
 			case JsonType::Null:
 			case JsonType::Integer:
@@ -996,6 +1932,7 @@ namespace jjyou {
 			case JsonType::Bool:
 				return iterator(this, 0);
 			case JsonType::Array:
+				this->_unpack();
 				return iterator(this, this->_array.begin());
 			case JsonType::Object:
 				return iterator(this, this->_object.begin());
@@ -1004,8 +1941,8 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::begin(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::begin(void) const {
 			switch (this->_type) {
 			case JsonType::Null:
 			case JsonType::Integer:
@@ -1014,7 +1951,7 @@ namespace jjyou {
 			case JsonType::Bool:
 				return const_iterator(this, 0);
 			case JsonType::Array:
-				return const_iterator(this, this->_array.cbegin());
+				return const_iterator(this, this->_elements().cbegin());
 			case JsonType::Object:
 				return const_iterator(this, this->_object.cbegin());
 			default:
@@ -1022,13 +1959,13 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::cbegin(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::cbegin(void) const {
 			return this->begin();
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::end(void) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::end(void) {
 			switch (this->_type) {
 			case JsonType::Null:
 				return iterator(this, 0);
@@ -1038,6 +1975,7 @@ namespace jjyou {
 			case JsonType::Bool:
 				return iterator(this, 1);
 			case JsonType::Array:
+				this->_unpack();
 				return iterator(this, this->_array.end());
 			case JsonType::Object:
 				return iterator(this, this->_object.end());
@@ -1046,8 +1984,8 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::end(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::end(void) const {
 			switch (this->_type) {
 			case JsonType::Null:
 				return const_iterator(this, 0);
@@ -1057,7 +1995,7 @@ namespace jjyou {
 			case JsonType::Bool:
 				return const_iterator(this, 1);
 			case JsonType::Array:
-				return const_iterator(this, this->_array.cend());
+				return const_iterator(this, this->_elements().cend());
 			case JsonType::Object:
 				return const_iterator(this, this->_object.cend());
 			default:
@@ -1065,27 +2003,299 @@ namespace jjyou {
 			}
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::cend(void) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::cend(void) const {
 			return this->end();
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::find(const StringType& key) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::find(const StringType& key) {
 			if (this->_type != JsonType::Object)
 				throw std::out_of_range("`JsonIterator Json::find(const StringType&)` is valid only if the Json container is an object.");
 			return iterator(this, this->_object.find(key));
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy>::find(const StringType& key) const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::find(const StringType& key) const {
 			if (this->_type != JsonType::Object)
 				throw std::out_of_range("`JsonConstIterator Json::find(const StringType&) const` is valid only if the Json container is an object.");
 			return const_iterator(this, this->_object.find(key));
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy>::_reset(void) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::extract(const StringType& key) {
+			if (this->_type != JsonType::Object)
+				throw std::out_of_range("`Json Json::extract(const StringType&)` is valid only if the Json container is an object.");
+			auto iter = this->_object.find(key);
+			if (iter == this->_object.end())
+				throw std::out_of_range("`Json Json::extract(const StringType&)` is valid only if the Json container contains the key.");
+			Json res(std::move(iter->second));
+			this->_object.erase(iter);
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::uint64_t Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_mix(std::uint64_t x) {
+			// Finalizer of splitmix64.
+			x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+			return x ^ (x >> 31);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::uint64_t Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::hash(void) const {
+			return this->_hash(nullptr);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		std::uint64_t Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_hash(_HashMemo* memo) const {
+			const bool container = (this->_type == JsonType::Array || this->_type == JsonType::Object);
+			if (memo && container) {
+				auto iter = memo->find(this);
+				if (iter != memo->end())
+					return iter->second;
+			}
+			this->_decode();
+			std::uint64_t res = 0;
+			switch (this->_type) {
+			case JsonType::Null:
+				break;
+			case JsonType::Integer:
+				res = static_cast<std::uint64_t>(std::hash<IntegerType>()(this->_integer));
+				break;
+			case JsonType::Floating:
+				res = static_cast<std::uint64_t>(std::hash<FloatingType>()(this->_floating));
+				break;
+			case JsonType::String:
+				res = static_cast<std::uint64_t>(std::hash<std::basic_string_view<CharType>>()(std::basic_string_view<CharType>(this->_string.data(), this->_string.size())));
+				break;
+			case JsonType::Bool:
+				res = static_cast<std::uint64_t>(std::hash<BoolType>()(this->_bool));
+				break;
+			case JsonType::Array:
+				// Order-dependent.
+				res = static_cast<std::uint64_t>(this->size());
+				// The same as for the unpacked array, so that it stays valid after unpacking.
+				if (this->_packed == _Packing::Integer) {
+					for (const IntegerType& number : this->_integers)
+						res = Json::_mix(res + Json(number).hash());
+				}
+				else if (this->_packed == _Packing::Floating) {
+					for (const FloatingType& number : this->_floatings)
+						res = Json::_mix(res + Json(number).hash());
+				}
+				else {
+					for (const Json& element : this->_array)
+						res = Json::_mix(res + element._hash(memo));
+				}
+				break;
+			case JsonType::Object:
+				// Order-independent, as `operator==` of `JsonOrderedObject`.
+				res = static_cast<std::uint64_t>(this->_object.size());
+				for (const auto& member : this->_object) {
+					std::uint64_t key = static_cast<std::uint64_t>(std::hash<std::basic_string_view<CharType>>()(std::basic_string_view<CharType>(member.first.data(), member.first.size())));
+					res += Json::_mix(key ^ Json::_mix(member.second._hash(memo)));
+				}
+				break;
+			default:
+				throw std::out_of_range("Invalid Json type.");
+			}
+			res = Json::_mix(res + static_cast<std::uint64_t>(this->_type) * 0x9e3779b97f4a7c15ULL);
+			if (memo && container)
+				memo->emplace(this, res);
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::diff(const Json& source, const Json& target) requires (!JsonIsStringView<StringTy>) {
+			Json res(JsonType::Array);
+			typename JsonOwningString<StringTy>::type path{};
+			_HashMemo memo{};
+			Json::_diff(source, target, path, res._array, memo);
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_diff(const Json& source, const Json& target, typename JsonOwningString<StringTy>::type& path, ArrayType& patch, _HashMemo& memo) {
+			using PathType = typename JsonOwningString<StringTy>::type;
+			auto literal = [](const char* text) -> StringType {
+				StringType res{};
+				for (; *text; ++text)
+					res.push_back(static_cast<CharType>(*text));
+				return res;
+			};
+			auto operation = [&](const char* op, const PathType& where, const Json* value) -> void {
+				Json res(JsonType::Object);
+				res._object.emplace(literal("op"), Json(literal(op)));
+				res._object.emplace(literal("path"), Json(StringType(where.data(), where.size())));
+				if (value)
+					res._object.emplace(literal("value"), *value);
+				patch.push_back(std::move(res));
+			};
+			// Append a reference token to `path`, escaping '~' and '/' as in RFC 6901.
+			auto pushKey = [&path](const StringType& key) -> void {
+				path.push_back(static_cast<CharType>('/'));
+				for (CharType c : key) {
+					if (c == static_cast<CharType>('~')) {
+						path.push_back(static_cast<CharType>('~'));
+						path.push_back(static_cast<CharType>('0'));
+					}
+					else if (c == static_cast<CharType>('/')) {
+						path.push_back(static_cast<CharType>('~'));
+						path.push_back(static_cast<CharType>('1'));
+					}
+					else {
+						path.push_back(c);
+					}
+				}
+			};
+			auto pushIndex = [&path](std::size_t index) -> void {
+				path.push_back(static_cast<CharType>('/'));
+				for (char c : std::to_string(index))
+					path.push_back(static_cast<CharType>(c));
+			};
+			// Equal hashes only suggest equal subtrees, since hashes can collide. Confirm with `operator==`.
+			if (source._hash(&memo) == target._hash(&memo) && source == target)
+				return;
+			const std::size_t length = path.size();
+			if (source._type == JsonType::Object && target._type == JsonType::Object) {
+				for (const auto& member : source._object) {
+					pushKey(member.first);
+					auto iter = target._object.find(member.first);
+					if (iter == target._object.end())
+						operation("remove", path, nullptr);
+					else
+						Json::_diff(member.second, iter->second, path, patch, memo);
+					path.resize(length);
+				}
+				for (const auto& member : target._object) {
+					if (source._object.find(member.first) != source._object.end())
+						continue;
+					pushKey(member.first);
+					operation("add", path, &member.second);
+					path.resize(length);
+				}
+			}
+			else if (source._type == JsonType::Array && target._type == JsonType::Array) {
+				// Packed arrays are not unpacked, since both are const. Their numbers are copied
+				// to temporary elements instead, which `_hash` does not memoize.
+				std::vector<Json> packedFrom{}, packedTo{};
+				if (source._packed != _Packing::None)
+					packedFrom = source._packedVector<Json>();
+				if (target._packed != _Packing::None)
+					packedTo = target._packedVector<Json>();
+				std::span<const Json> from = (source._packed != _Packing::None) ? std::span<const Json>(packedFrom) : std::span<const Json>(source._array);
+				std::span<const Json> to = (target._packed != _Packing::None) ? std::span<const Json>(packedTo) : std::span<const Json>(target._array);
+				std::size_t common = std::min(from.size(), to.size());
+				std::size_t prefix = 0;
+				auto same = [&memo](const Json& json1, const Json& json2) -> bool {
+					return json1._hash(&memo) == json2._hash(&memo) && json1 == json2;
+				};
+				while (prefix < common && same(from[prefix], to[prefix]))
+					++prefix;
+				std::size_t suffix = 0;
+				while (suffix < common - prefix && same(from[from.size() - 1 - suffix], to[to.size() - 1 - suffix]))
+					++suffix;
+				// Diff the changed middle parts in place, then add or remove the rest of the longer one.
+				const std::size_t fromEnd = from.size() - suffix;
+				const std::size_t toEnd = to.size() - suffix;
+				const std::size_t middle = std::min(fromEnd, toEnd) - prefix;
+				for (std::size_t i = prefix; i < prefix + middle; ++i) {
+					pushIndex(i);
+					Json::_diff(from[i], to[i], path, patch, memo);
+					path.resize(length);
+				}
+				for (std::size_t i = prefix + middle; i < toEnd; ++i) {
+					pushIndex(i);
+					operation("add", path, &to[i]);
+					path.resize(length);
+				}
+				for (std::size_t i = fromEnd; i > prefix + middle; --i) {
+					pushIndex(i - 1);
+					operation("remove", path, nullptr);
+					path.resize(length);
+				}
+			}
+			else {
+				operation("replace", path, &target);
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_reset(void) {
+			if (this->_type != JsonType::Array && this->_type != JsonType::Object) {
+				this->_destroy();
+				return;
+			}
+			// Containers are destroyed recursively up to a small depth, which is the fastest
+			// for usual documents. Deeper containers are destroyed from a heap stack instead.
+			constexpr std::size_t recursionLimit = 64;
+			thread_local std::size_t depth = 0;
+			if (depth >= recursionLimit)
+				this->_teardown();
+			++depth;
+			this->_destroy();
+			--depth;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_teardown(void) noexcept {
+			// Move the nested containers out to a pending list and destroy them one by one,
+			// each after moving out its own nested containers. Every container is then
+			// destroyed with only flat children, so the call stack does not grow with the depth.
+			// The list is linked through the first child of each pending container, so the
+			// teardown only moves Json containers and never allocates memory.
+			Json pending{};
+			auto detachChildren = [&pending](Json& json) -> void {
+				if (json._type == JsonType::Array && json._packed == _Packing::None) {
+					for (Json& element : json._array)
+						Json::_detach(element, pending);
+				}
+				else if (json._type == JsonType::Object) {
+					for (auto&& member : json._object)
+						Json::_detach(member.second, pending);
+				}
+			};
+			detachChildren(*this);
+			while (pending._type != JsonType::Null) {
+				Json json(std::move(pending));
+				pending = std::move(*Json::_firstChild(json));
+				detachChildren(json);
+				json._destroy();
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>* Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_firstChild(Json& json) {
+			if (json._type == JsonType::Array && json._packed == _Packing::None && !json._array.empty())
+				return &json._array.front();
+			if (json._type == JsonType::Object && !json._object.empty())
+				return &json._object.begin()->second;
+			return nullptr;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_detach(Json& child, Json& pending) noexcept {
+			if (Json::_firstChild(child) == nullptr)
+				return;
+			// Push `child` on the list by storing the list in its first child. The first child
+			// is moved out before, and pushed in turn if it is a non-empty container.
+			Json json(std::move(child));
+			while (Json* first = Json::_firstChild(json)) {
+				Json next(std::move(*first));
+				*first = std::move(pending);
+				pending = std::move(json);
+				json = std::move(next);
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_destroy(void) {
+			if (this->_lazy) {
+				this->_lazy = false;
+				this->_type = JsonType::Null;
+				return;
+			}
 			switch (this->_type) {
 			case JsonType::Null:
 				break;
@@ -1102,7 +2312,13 @@ namespace jjyou {
 				this->_bool.~BoolType();
 				break;
 			case JsonType::Array:
-				this->_array.~ArrayType();
+				if (this->_packed == _Packing::Integer)
+					this->_integers.~_PackedIntegers();
+				else if (this->_packed == _Packing::Floating)
+					this->_floatings.~_PackedFloatings();
+				else
+					this->_array.~ArrayType();
+				this->_packed = _Packing::None;
 				break;
 			case JsonType::Object:
 				this->_object.~ObjectType();
@@ -1113,8 +2329,14 @@ namespace jjyou {
 			this->_type = JsonType::Null;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy>::_assign(const Json& json) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_assign(const Json& json) {
+			if (json._lazy) {
+				new (&this->_raw) _Raw(json._raw);
+				this->_lazy = true;
+				this->_type = json._type;
+				return;
+			}
 			switch (json._type) {
 			case JsonType::Null:
 				break;
@@ -1131,7 +2353,13 @@ namespace jjyou {
 				new (&this->_bool) BoolType(json._bool);
 				break;
 			case JsonType::Array:
-				new (&this->_array) ArrayType(json._array);
+				if (json._packed == _Packing::Integer)
+					new (&this->_integers) _PackedIntegers(json._integers);
+				else if (json._packed == _Packing::Floating)
+					new (&this->_floatings) _PackedFloatings(json._floatings);
+				else
+					new (&this->_array) ArrayType(json._array);
+				this->_packed = json._packed;
 				break;
 			case JsonType::Object:
 				new (&this->_object) ObjectType(json._object);
@@ -1142,8 +2370,16 @@ namespace jjyou {
 			this->_type = json._type;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy>::_assign(Json&& json) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_assign(Json&& json) {
+			if (json._lazy) {
+				new (&this->_raw) _Raw(json._raw);
+				json._lazy = false;
+				this->_lazy = true;
+				this->_type = json._type;
+				json._type = JsonType::Null;
+				return;
+			}
 			switch (json._type) {
 			case JsonType::Null:
 				break;
@@ -1164,8 +2400,20 @@ namespace jjyou {
 				json._bool.~BoolType();
 				break;
 			case JsonType::Array:
-				new (&this->_array) ArrayType(std::move(json._array));
-				json._array.~ArrayType();
+				if (json._packed == _Packing::Integer) {
+					new (&this->_integers) _PackedIntegers(std::move(json._integers));
+					json._integers.~_PackedIntegers();
+				}
+				else if (json._packed == _Packing::Floating) {
+					new (&this->_floatings) _PackedFloatings(std::move(json._floatings));
+					json._floatings.~_PackedFloatings();
+				}
+				else {
+					new (&this->_array) ArrayType(std::move(json._array));
+					json._array.~ArrayType();
+				}
+				this->_packed = json._packed;
+				json._packed = _Packing::None;
 				break;
 			case JsonType::Object:
 				new (&this->_object) ObjectType(std::move(json._object));
@@ -1178,8 +2426,8 @@ namespace jjyou {
 			json._type = JsonType::Null;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy>::_create(JsonType type) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_create(JsonType type, const AllocatorType& allocator) {
 			switch (type) {
 			case JsonType::Null:
 				break;
@@ -1190,16 +2438,19 @@ namespace jjyou {
 				new (&this->_floating) FloatingType();
 				break;
 			case JsonType::String:
-				new (&this->_string) StringType();
+				if constexpr (std::is_constructible_v<StringType, const AllocatorType&>)
+					new (&this->_string) StringType(allocator);
+				else
+					new (&this->_string) StringType();
 				break;
 			case JsonType::Bool:
 				new (&this->_bool) BoolType();
 				break;
 			case JsonType::Array:
-				new (&this->_array) ArrayType();
+				new (&this->_array) ArrayType(allocator);
 				break;
 			case JsonType::Object:
-				new (&this->_object) ObjectType();
+				new (&this->_object) ObjectType(allocator);
 				break;
 			default:
 				throw std::out_of_range("Invalid Json type.");
@@ -1207,91 +2458,156 @@ namespace jjyou {
 			this->_type = type;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		void Json<IntegerTy, FloatingTy, StringTy, BoolTy>::_print(std::basic_ostream<CharType>& out, int indent) const {
-			switch (this->_type) {
-			case JsonType::Null:
-				out << StringType(indent, '\t') << "null";
-				break;
-			case JsonType::Integer:
-				out << StringType(indent, '\t') << this->_integer;
-				break;
-			case JsonType::Floating:
-				out << StringType(indent, '\t') << this->_floating;
-				break;
-			case JsonType::String:
-				out << StringType(indent, '\t') << '\"';
-				for (const CharType& c : this->_string) {
-					switch (c) {
-					case static_cast<CharType>('\"'):
-						out << '\\' << '\"';
-						break;
-					case static_cast<CharType>('\\'):
-						out << '\\' << '\\';
-						break;
-					case static_cast<CharType>('/'):
-						out << '\\' << '/';
-						break;
-					case static_cast<CharType>('\b'):
-						out << '\\' << 'b';
-						break;
-					case static_cast<CharType>('\f'):
-						out << '\\' << 'f';
-						break;
-					case static_cast<CharType>('\n'):
-						out << '\\' << 'n';
-						break;
-					case static_cast<CharType>('\r'):
-						out << '\\' << 'r';
-						break;
-					case static_cast<CharType>('\t'):
-						out << '\\' << 't';
-						break;
-					default:
-						out << c;
-						break;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonOwningString<StringTy>::type Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::dump(const DumpOptions& options) const {
+			typename JsonOwningString<StringType>::type res{};
+			this->dump([&res](const CharType* data, std::size_t size) -> void {
+				res.append(data, size);
+			}, options);
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class SinkTy> requires std::is_invocable_v<SinkTy&, const typename StringTy::value_type*, std::size_t>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::dump(SinkTy&& sink, const DumpOptions& options) const {
+			JsonSerializer<CharType, SinkTy&> serializer(sink, options);
+			this->_emit(serializer);
+			serializer.flush();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class HandlerTy>
+		void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_emit(HandlerTy& handler) const {
+			// Open containers with their current child, innermost last, instead of one call per level.
+			struct Frame {
+				const Json* json;
+				typename ArrayType::const_iterator element;
+				typename ObjectType::const_iterator member;
+			};
+			std::vector<Frame> stack{};
+			const Json* json = this;
+			while (true) {
+				switch (json->_type) {
+				case JsonType::Null:
+					handler.onNull();
+					break;
+				case JsonType::Integer:
+					if (!json->_lazy)
+						handler.onInteger(json->_integer);
+					else if constexpr (requires { handler.onRawInteger(std::basic_string_view<CharType>()); })
+						handler.onRawInteger(std::basic_string_view<CharType>(json->_raw.text, json->_raw.size));
+					else
+						handler.onInteger(std::get<0>(Json::_convertNumber(JsonType::Integer, std::basic_string_view<CharType>(json->_raw.text, json->_raw.size)).data));
+					break;
+				case JsonType::Floating:
+					if (!json->_lazy)
+						handler.onFloating(json->_floating);
+					else if constexpr (requires { handler.onRawFloating(std::basic_string_view<CharType>()); })
+						handler.onRawFloating(std::basic_string_view<CharType>(json->_raw.text, json->_raw.size));
+					else
+						handler.onFloating(std::get<1>(Json::_convertNumber(JsonType::Floating, std::basic_string_view<CharType>(json->_raw.text, json->_raw.size)).data));
+					break;
+				case JsonType::String:
+					handler.onString(std::basic_string_view<CharType>(json->_string));
+					break;
+				case JsonType::Bool:
+					handler.onBool(json->_bool);
+					break;
+				case JsonType::Array:
+					// Handlers that need the size up front, such as `JsonBinaryWriter`, accept it.
+					if constexpr (requires { handler.onStartArray(std::size_t()); })
+						handler.onStartArray(json->size());
+					else
+						handler.onStartArray();
+					if (json->_packed == _Packing::Integer) {
+						for (const IntegerType& number : json->_integers)
+							handler.onInteger(number);
 					}
+					else if (json->_packed == _Packing::Floating) {
+						for (const FloatingType& number : json->_floatings)
+							handler.onFloating(number);
+					}
+					else if (!json->_array.empty()) {
+						stack.push_back(Frame{ json, json->_array.begin(), {} });
+						json = &*stack.back().element;
+						continue;
+					}
+					handler.onEndArray();
+					break;
+				case JsonType::Object:
+					if constexpr (requires { handler.onStartObject(std::size_t()); })
+						handler.onStartObject(json->_object.size());
+					else
+						handler.onStartObject();
+					if (!json->_object.empty()) {
+						stack.push_back(Frame{ json, {}, json->_object.begin() });
+						handler.onKey(std::basic_string_view<CharType>(stack.back().member->first));
+						json = &stack.back().member->second;
+						continue;
+					}
+					handler.onEndObject();
+					break;
+				default:
+					throw std::out_of_range("Invalid Json type.");
 				}
-				out << '\"';
-				break;
-			case JsonType::Bool:
-				out << StringType(indent, '\t') << std::boolalpha << this->_bool;
-				break;
-			case JsonType::Array:
-				out << StringType(indent, '\t') << "[" << std::endl;
-				for (auto iter = this->_array.cbegin(); iter != this->_array.cend();) {
-					iter->_print(out, indent + 1);
-					++iter;
-					if (iter != this->_array.cend()) out << ",";
-					out << std::endl;
-				}
-				out << StringType(indent, '\t') << "]";
-				break;
-			case JsonType::Object:
-				out << StringType(indent, '\t') << "{" << std::endl;
-				for (auto iter = this->_object.cbegin(); iter != this->_object.cend();) {
-					out << StringType(indent + 1, '\t') << '\"' << iter->first << '\"' << " : ";
-					if (iter->second._type == JsonType::Array || iter->second._type == JsonType::Object) {
-						out << std::endl;
-						iter->second._print(out, indent + 2);
+				// `json` is done. Close the containers it completes and move to the next child.
+				while (true) {
+					if (stack.empty())
+						return;
+					Frame& frame = stack.back();
+					if (frame.json->_type == JsonType::Array) {
+						if (++frame.element != frame.json->_array.end()) {
+							json = &*frame.element;
+							break;
+						}
+						handler.onEndArray();
 					}
 					else {
-						iter->second._print(out, 0);
+						if (++frame.member != frame.json->_object.end()) {
+							handler.onKey(std::basic_string_view<CharType>(frame.member->first));
+							json = &frame.member->second;
+							break;
+						}
+						handler.onEndObject();
 					}
-					++iter;
-					if (iter != this->_object.cend()) out << ",";
-					out << std::endl;
+					stack.pop_back();
 				}
-				out << StringType(indent, '\t') << "}" << std::endl;
-				break;
-			default:
-				throw std::out_of_range("Invalid Json type.");
 			}
 		}
 
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::vector<std::uint8_t> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::toCBOR(void) const {
+			std::vector<std::uint8_t> res;
+			this->toCBOR([&res](const std::uint8_t* data, std::size_t size) -> void {
+				res.insert(res.end(), data, data + size);
+			});
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class SinkTy> requires std::is_invocable_v<SinkTy&, const std::uint8_t*, std::size_t>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::toCBOR(SinkTy&& sink) const {
+			JsonBinaryWriter<CharType, SinkTy&> writer(sink, JsonBinaryFormat::CBOR);
+			this->_emit(writer);
+			writer.flush();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::vector<std::uint8_t> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::toMsgPack(void) const {
+			std::vector<std::uint8_t> res;
+			this->toMsgPack([&res](const std::uint8_t* data, std::size_t size) -> void {
+				res.insert(res.end(), data, data + size);
+			});
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class SinkTy> requires std::is_invocable_v<SinkTy&, const std::uint8_t*, std::size_t>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::toMsgPack(SinkTy&& sink) const {
+			JsonBinaryWriter<CharType, SinkTy&> writer(sink, JsonBinaryFormat::MsgPack);
+			this->_emit(writer);
+			writer.flush();
+		}
+
 		#define JJYOU_IO_JSON_ITERATOR_EQUAL_IMPL(IterTy1, IterTy2)																							\
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>																			\
-		inline bool operator==(const IterTy1<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const IterTy2<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2)\
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>																			\
+		inline bool operator==(const IterTy1<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const IterTy2<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2)\
 		{																																					\
 			return																																			\
 				(iter1.pJson == iter2.pJson &&																												\
@@ -1305,8 +2621,8 @@ namespace jjyou {
 		}
 
 		#define JJYOU_IO_JSON_ITERATOR_UNEQUAL_IMPL(IterTy1, IterTy2)																						\
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>																			\
-		inline bool operator!=(const IterTy1<IntegerTy, FloatingTy, StringTy, BoolTy>& iter1, const IterTy2<IntegerTy, FloatingTy, StringTy, BoolTy>& iter2)\
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>																			\
+		inline bool operator!=(const IterTy1<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter1, const IterTy2<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& iter2)\
 		{																																					\
 			return !(iter1 == iter2);																														\
 		}
@@ -1324,9 +2640,9 @@ namespace jjyou {
 		#undef JJYOU_IO_JSON_ITERATOR_EQUAL_IMPL
 		#undef JJYOU_IO_JSON_ITERATOR_UNEQUAL_IMPL
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>() const {
-			JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy> ret;
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>() const {
+			JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> ret;
 			ret.pJson = this->pJson;
 			ret.pos = this->pos;
 			ret.objectIter = this->objectIter;
@@ -1334,15 +2650,15 @@ namespace jjyou {
 			return ret;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy> JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator++(int) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator++(int) {
 			JsonIterator ret = *this;
 			++(*this);
 			return ret;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator++(void) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator++(void) {
 			if (this->pJson) {
 				if (this->pJson->type() == JsonType::Array)
 					++this->arrayIter;
@@ -1354,15 +2670,15 @@ namespace jjyou {
 			return *this;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy> JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator--(int) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator--(int) {
 			JsonIterator ret = *this;
 			--(*this);
 			return ret;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator--(void) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator--(void) {
 			if (this->pJson) {
 				if (this->pJson->type() == JsonType::Array)
 					--this->arrayIter;
@@ -1374,8 +2690,8 @@ namespace jjyou {
 			return *this;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::reference JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator*() const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::reference JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator*() const {
 			if (this->pJson->type() == JsonType::Array)
 				return *this->arrayIter;
 			else if (this->pJson->type() == JsonType::Object)
@@ -1384,8 +2700,8 @@ namespace jjyou {
 				return *this->pJson;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::pointer JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator->() const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::pointer JsonIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator->() const {
 			if (this->pJson->type() == JsonType::Array)
 				return &*this->arrayIter;
 			else if (this->pJson->type() == JsonType::Object)
@@ -1394,15 +2710,15 @@ namespace jjyou {
 				return this->pJson;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy> JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator++(int) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator++(int) {
 			JsonConstIterator ret = *this;
 			++(*this);
 			return ret;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator++(void) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator++(void) {
 			if (this->pJson) {
 				if (this->pJson->type() == JsonType::Array)
 					++this->arrayIter;
@@ -1414,15 +2730,15 @@ namespace jjyou {
 			return *this;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy> JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator--(int) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator--(int) {
 			JsonConstIterator ret = *this;
 			--(*this);
 			return ret;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>& JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator--(void) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator--(void) {
 			if (this->pJson) {
 				if (this->pJson->type() == JsonType::Array)
 					--this->arrayIter;
@@ -1434,8 +2750,8 @@ namespace jjyou {
 			return *this;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::reference JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator*() const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::reference JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator*() const {
 			if (this->pJson->type() == JsonType::Array)
 				return *this->arrayIter;
 			else if (this->pJson->type() == JsonType::Object)
@@ -1444,8 +2760,8 @@ namespace jjyou {
 				return *this->pJson;
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		inline typename JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::pointer JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy>::operator->() const {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::pointer JsonConstIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator->() const {
 			if (this->pJson->type() == JsonType::Array)
 				return &*this->arrayIter;
 			else if (this->pJson->type() == JsonType::Object)
@@ -1463,91 +2779,261 @@ namespace jjyou {
 		private:
 			using StringType = StringTy;
 			using CharType = StringType::value_type;
+			using StringViewType = std::basic_string_view<CharType>;
 			using StreamType = std::basic_istream<CharType>;
+			// Contiguous sources are lexed directly from memory through `rangeCurr`.
+			// Only real streams go through `stream`, in which case the range is empty.
 			JsonInputAdapter(StreamType& stream) : stream(&stream, [](StreamType*) -> void { return; }) {}
-			JsonInputAdapter(const StringType& string) : stream(new std::basic_istringstream<CharType>(string)) {}
-			JsonInputAdapter(StringType&& string) : stream(new std::basic_istringstream<CharType>(std::move(string))) {}
-			JsonInputAdapter(const CharType* cstring) : stream(new std::basic_istringstream<CharType>(std::move(StringType(cstring)))) {}
-			JsonInputAdapter(const std::filesystem::path& fileName) : stream(new std::basic_ifstream<CharType>(fileName)) { if (!std::reinterpret_pointer_cast<std::basic_ifstream<CharType>>(this->stream)->is_open()) throw std::runtime_error("Cannot open input json file \"" + fileName.string() + "\"."); }
-			CharType get(void) {
-				CharType res;
-				if (!this->ungets.empty()) {
-					res = this->ungets.top();
-					this->ungets.pop();
-				}
-				else {
-					res = static_cast<CharType>(this->stream->get());
+			JsonInputAdapter(const CharType* first, const CharType* last) : rangeBegin(first), rangeCurr(first), rangeEnd(last) {}
+			JsonInputAdapter(StringViewType view) : JsonInputAdapter(view.data(), view.data() + view.size()) {}
+			JsonInputAdapter(const CharType* cstring) : JsonInputAdapter(StringViewType(cstring)) {}
+			JsonInputAdapter(const StringType& string) : JsonInputAdapter(string.data(), string.data() + string.size()) {}
+			JsonInputAdapter(StringType&& string) { this->_own(std::make_shared<const StringType>(std::move(string))); }
+			JsonInputAdapter(const std::vector<CharType>& buffer) : JsonInputAdapter(buffer.data(), buffer.data() + buffer.size()) {}
+			JsonInputAdapter(std::vector<CharType>&& buffer) { this->_own(std::make_shared<const std::vector<CharType>>(std::move(buffer))); }
+			// Only an exact `std::filesystem::path` selects this overload, so that other
+			// string types convertible to both a path and a view are lexed as text.
+			template <class PathTy> requires std::is_same_v<PathTy, std::filesystem::path>
+			JsonInputAdapter(const PathTy& fileName) {
+				// Non-empty regular files are mapped and lexed in place. Pipes, special
+				// files, zero-size files such as procfs entries, and wide character
+				// types fall back to buffered stream reads.
+				if constexpr (sizeof(CharType) == 1) {
+					auto file = std::make_shared<const MappedFile>(fileName, MappedFileHint::Sequential);
+					if (file->isMapped()) {
+						this->rangeBegin = this->rangeCurr = reinterpret_cast<const CharType*>(file->data());
+						this->rangeEnd = this->rangeBegin + file->size();
+						this->owner = std::move(file);
+						return;
+					}
 				}
-				return res;
+				this->stream.reset(new std::basic_ifstream<CharType>(fileName));
+				if (!std::reinterpret_pointer_cast<std::basic_ifstream<CharType>>(this->stream)->is_open())
+					throw std::runtime_error("Cannot open input json file \"" + fileName.string() + "\".");
 			}
-			CharType peek(void) {
-				CharType res;
-				if (!this->ungets.empty()) {
-					res = this->ungets.top();
-				}
-				else {
-					res = static_cast<CharType>(this->stream->peek());
-				}
-				return res;
+			template <class BufferTy>
+			void _own(std::shared_ptr<const BufferTy>&& buffer) {
+				this->rangeBegin = this->rangeCurr = buffer->data();
+				this->rangeEnd = buffer->data() + buffer->size();
+				this->owner = std::move(buffer);
+			}
+			CharType get(void) {
+				if (this->rangeCurr != this->rangeEnd)
+					return *this->rangeCurr++;
+				if (this->stream)
+					return static_cast<CharType>(this->stream->get());
+				return static_cast<CharType>(std::char_traits<CharType>::eof());
+			}
+			CharType peek(void) const {
+				if (this->rangeCurr != this->rangeEnd)
+					return *this->rangeCurr;
+				if (this->stream)
+					return static_cast<CharType>(this->stream->peek());
+				return static_cast<CharType>(std::char_traits<CharType>::eof());
 			}
-			void unget(CharType c) {
-				this->ungets.push(c);
-			}
-			bool good(void) { return this->stream->good(); }
-			bool eof(void) { return this->ungets.empty() && this->stream->eof(); }
-			bool fail(void) { return this->stream->fail(); }
-			bool bad(void) { return this->stream->bad(); }
-			static std::string _toStdString(const StringType& str);
-			std::shared_ptr<StreamType> stream;
-			std::stack<CharType> ungets{};
-			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy>
+			bool isRange(void) const { return !this->stream; }
+			bool good(void) const { return this->stream ? this->stream->good() : this->rangeCurr != this->rangeEnd; }
+			bool eof(void) const { return this->rangeCurr == this->rangeEnd && (!this->stream || this->stream->eof()); }
+			bool fail(void) const { return this->stream && this->stream->fail(); }
+			bool bad(void) const { return this->stream && this->stream->bad(); }
+			static std::string _toStdString(const std::basic_string<CharType>& str);
+			std::shared_ptr<StreamType> stream{};
+			std::shared_ptr<const void> owner{};
+			const CharType* rangeBegin = nullptr;
+			const CharType* rangeCurr = nullptr;
+			const CharType* rangeEnd = nullptr;
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
 			friend class Json;
-			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy>
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
 			friend class JsonLexer;
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
+			friend class JsonView;
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
+			friend class JsonPushParser;
+			template <class _JsonTy>
+			friend class JsonBinder;
 		};
 		
-		template <>
-		inline std::string JsonInputAdapter<std::string>::_toStdString(const StringType& str) {
-			return str;
-		}
-
-		template <>
-		inline std::string JsonInputAdapter<std::wstring>::_toStdString(const StringType& str) {
-			std::string res; res.reserve(str.length() * sizeof(typename StringType::value_type));
-			for (const CharType& c : str) {
-				for (std::size_t i = 0; i < sizeof(CharType); ++i)
-					if (reinterpret_cast<const char*>(&c)[i] != 0)
-						res.push_back(reinterpret_cast<const char*>(&c)[i]);
+		template <class StringTy>
+		inline std::string JsonInputAdapter<StringTy>::_toStdString(const std::basic_string<CharType>& str) {
+			if constexpr (std::is_same_v<CharType, char>) {
+				return str;
+			}
+			else if constexpr (sizeof(CharType) == 1) {
+				return std::string(reinterpret_cast<const char*>(str.data()), str.size());
+			}
+			else {
+				std::string res; res.reserve(str.length() * sizeof(CharType));
+				for (const CharType& c : str) {
+					for (std::size_t i = 0; i < sizeof(CharType); ++i)
+						if (reinterpret_cast<const char*>(&c)[i] != 0)
+							res.push_back(reinterpret_cast<const char*>(&c)[i]);
+				}
+				return res;
 			}
-			return res;
 		}
 
-		template <>
-		inline std::string JsonInputAdapter<std::u8string>::_toStdString(const StringType& str) {
-			return std::string(reinterpret_cast<const char*>(str.c_str()));
-		}
+		/*============================================================
+		 *                 Structural index (stage 1)
+		 *============================================================*/
 
-		template <>
-		inline std::string JsonInputAdapter<std::u16string>::_toStdString(const StringType& str) {
-			std::string res; res.reserve(str.length() * sizeof(typename StringType::value_type));
-			for (const CharType& c : str) {
-				for (std::size_t i = 0; i < sizeof(CharType); ++i)
-					if (reinterpret_cast<const char*>(&c)[i] != 0)
-						res.push_back(reinterpret_cast<const char*>(&c)[i]);
+		// Stage 1 of the two-stage parser. Positions of all tokens outside strings
+		// (structural characters, opening quotes, and the first character of every
+		// other token) are collected 64 bytes at a time with SIMD comparisons, in
+		// the style of simdjson. Stage 2 is the ordinary lexer, which jumps over
+		// whitespace to the next indexed position instead of scanning it.
+		class JsonStructuralIndex {
+		private:
+			struct _Masks {
+				std::uint64_t quote = 0;
+				std::uint64_t backslash = 0;
+				std::uint64_t whitespace = 0;
+				std::uint64_t op = 0;
+			};
+			JsonStructuralIndex(const char* first, const char* last) {
+				const std::size_t size = static_cast<std::size_t>(last - first);
+				this->positions.reserve(size / 8 + 1);
+				std::uint64_t prevEscaped = 0ULL;
+				std::uint64_t prevInString = 0ULL;
+				std::uint64_t prevScalar = 0ULL;
+				for (std::size_t base = 0; base < size; base += 64) {
+					_Masks masks{};
+					if (size - base >= 64) {
+						masks = _classify(first + base);
+					}
+					else {
+						char block[64];
+						std::memset(block, ' ', sizeof(block));
+						std::memcpy(block, first + base, size - base);
+						masks = _classify(block);
+					}
+					std::uint64_t escaped = _escaped(masks.backslash, prevEscaped);
+					std::uint64_t quote = masks.quote & ~escaped;
+					std::uint64_t inString = _prefixXor(quote) ^ prevInString;
+					prevInString = static_cast<std::uint64_t>(static_cast<std::int64_t>(inString) >> 63);
+					std::uint64_t scalar = ~(masks.op | masks.whitespace | quote | inString);
+					std::uint64_t scalarStart = scalar & ~((scalar << 1) | prevScalar);
+					prevScalar = scalar >> 63;
+					std::uint64_t bits = (masks.op & ~inString) | (quote & inString) | scalarStart;
+					while (bits) {
+						this->positions.push_back(base + static_cast<std::size_t>(std::countr_zero(bits)));
+						bits &= bits - 1ULL;
+					}
+				}
+				while (!this->positions.empty() && this->positions.back() >= size)
+					this->positions.pop_back();
+				this->positions.push_back(size);
 			}
-			return res;
-		}
-
-		template <>
-		inline std::string JsonInputAdapter<std::u32string>::_toStdString(const StringType& str) {
-			std::string res; res.reserve(str.length() * sizeof(typename StringType::value_type));
-			for (const CharType& c : str) {
-				for (std::size_t i = 0; i < sizeof(CharType); ++i)
-					if (reinterpret_cast<const char*>(&c)[i] != 0)
-						res.push_back(reinterpret_cast<const char*>(&c)[i]);
+			// Offset of the first indexed token at or after `offset`.
+			std::size_t next(std::size_t offset) {
+				while (this->positions[this->cursor] < offset)
+					++this->cursor;
+				return this->positions[this->cursor];
 			}
-			return res;
-		}
+			static _Masks _classify(const char* block) {
+				_Masks masks{};
+#if defined(__AVX2__)
+				for (int i = 0; i < 2; ++i) {
+					__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * i));
+					auto eq = [&v](char c) { return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)); };
+					auto bits = [](__m256i m) { return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m))); };
+					const int shift = 32 * i;
+					masks.quote |= bits(eq('\"')) << shift;
+					masks.backslash |= bits(eq('\\')) << shift;
+					masks.whitespace |= bits(_mm256_or_si256(_mm256_or_si256(eq(' '), eq('\t')), _mm256_or_si256(eq('\n'), eq('\r')))) << shift;
+					masks.op |= bits(_mm256_or_si256(
+						_mm256_or_si256(_mm256_or_si256(eq('{'), eq('}')), _mm256_or_si256(eq('['), eq(']'))),
+						_mm256_or_si256(eq(':'), eq(','))
+					)) << shift;
+				}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+				for (int i = 0; i < 4; ++i) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+					auto eq = [&v](char c) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); };
+					auto bits = [](__m128i m) { return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(m))); };
+					const int shift = 16 * i;
+					masks.quote |= bits(eq('\"')) << shift;
+					masks.backslash |= bits(eq('\\')) << shift;
+					masks.whitespace |= bits(_mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')))) << shift;
+					masks.op |= bits(_mm_or_si128(
+						_mm_or_si128(_mm_or_si128(eq('{'), eq('}')), _mm_or_si128(eq('['), eq(']'))),
+						_mm_or_si128(eq(':'), eq(','))
+					)) << shift;
+				}
+#else
+				for (int i = 0; i < 64; ++i) {
+					const std::uint64_t bit = 1ULL << i;
+					switch (block[i]) {
+					case '\"': masks.quote |= bit; break;
+					case '\\': masks.backslash |= bit; break;
+					case ' ': case '\t': case '\n': case '\r': masks.whitespace |= bit; break;
+					case '{': case '}': case '[': case ']': case ':': case ',': masks.op |= bit; break;
+					default: break;
+					}
+				}
+#endif
+				return masks;
+			}
+			// Characters preceded by an odd number of backslashes.
+			static std::uint64_t _escaped(std::uint64_t backslash, std::uint64_t& prevEscaped) {
+				constexpr std::uint64_t evenBits = 0x5555555555555555ULL;
+				constexpr std::uint64_t oddBits = ~evenBits;
+				std::uint64_t startEdges = backslash & ~(backslash << 1);
+				std::uint64_t evenStartMask = evenBits ^ prevEscaped;
+				std::uint64_t evenStarts = startEdges & evenStartMask;
+				std::uint64_t oddStarts = startEdges & ~evenStartMask;
+				std::uint64_t evenCarries = backslash + evenStarts;
+				std::uint64_t oddCarries = backslash + oddStarts;
+				bool endsOdd = oddCarries < backslash;
+				oddCarries |= prevEscaped;
+				prevEscaped = endsOdd ? 1ULL : 0ULL;
+				std::uint64_t evenCarryEnds = evenCarries & ~backslash;
+				std::uint64_t oddCarryEnds = oddCarries & ~backslash;
+				return (evenCarryEnds & oddBits) | (oddCarryEnds & evenBits);
+			}
+			static std::uint64_t _prefixXor(std::uint64_t bits) {
+				bits ^= bits << 1;
+				bits ^= bits << 2;
+				bits ^= bits << 4;
+				bits ^= bits << 8;
+				bits ^= bits << 16;
+				bits ^= bits << 32;
+				return bits;
+			}
+			// First quote or backslash in [first, last), or `last`.
+			static const char* _findQuoteOrBackslash(const char* first, const char* last) {
+#if defined(__AVX2__)
+				const __m256i quote = _mm256_set1_epi8('\"');
+				const __m256i backslash = _mm256_set1_epi8('\\');
+				for (; last - first >= 32; first += 32) {
+					__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+					int bits = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)));
+					if (bits)
+						return first + std::countr_zero(static_cast<std::uint32_t>(bits));
+				}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+				const __m128i quote = _mm_set1_epi8('\"');
+				const __m128i backslash = _mm_set1_epi8('\\');
+				for (; last - first >= 16; first += 16) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+					int bits = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+					if (bits)
+						return first + std::countr_zero(static_cast<std::uint32_t>(bits));
+				}
+#endif
+				while (first != last && *first != '\"' && *first != '\\')
+					++first;
+				return first;
+			}
+			std::vector<std::size_t> positions{};
+			std::size_t cursor = 0;
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
+			friend class Json;
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
+			friend class JsonLexer;
+			template <class _IntegerTy, class _FloatingTy, class _StringTy, class _BoolTy, class _ObjectPolicyTy>
+			friend class JsonView;
+		};
 
 		enum class JsonTokenType {
 			Unexpected = -1,
@@ -1589,35 +3075,49 @@ namespace jjyou {
 			return (out << to_string(type));
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
 		class JsonToken {
 		private:
 			using IntegerType = IntegerTy;
 			using FloatingType = FloatingTy;
-			using StringType = StringTy;
+			using StringType = typename JsonOwningString<StringTy>::type;
 			using BoolType = BoolTy;
+			using StringViewType = std::basic_string_view<typename StringTy::value_type>;
 			JsonTokenType type = JsonTokenType::End;
-			std::variant<IntegerTy, FloatingTy, StringType, BoolTy> data{};
+			// Set on integers out of the range of `IntegerType`, which are kept as floating points.
+			bool overflow = false;
+			// Strings without escape sequences in contiguous inputs are views into the input (index 4).
+			std::variant<IntegerTy, FloatingTy, StringType, BoolTy, StringViewType> data{};
+			// Line and column of contiguous inputs are only set by `JsonLexer::_locate`.
 			std::size_t line = 0U;
 			std::size_t col = 0U;
 			std::size_t pos = 0U;
 			JsonToken(void) = default;
 			JsonToken(JsonTokenType type, std::size_t line, std::size_t col, std::size_t pos) : type(type), data(), line(line), col(col), pos(pos) {}
-			friend class JsonLexer<IntegerTy, FloatingTy, StringTy, BoolTy>;
-			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy>;
+			StringViewType view(void) const {
+				if (this->data.index() == 4)
+					return std::get<4>(this->data);
+				return StringViewType(std::get<2>(this->data));
+			}
+			friend class JsonLexer<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend class JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			template <class _JsonTy>
+			friend class JsonBinder;
 		};
 
 		//https://www.json.org/json-en.html
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
 		class JsonLexer {
 		private:
 			using IntegerType = IntegerTy;
 			using FloatingType = FloatingTy;
-			using StringType = StringTy;
+			using StringType = typename JsonOwningString<StringTy>::type;
 			using BoolType = BoolTy;
 			using CharType = StringTy::value_type;
 			using InputAdapter = JsonInputAdapter<StringType>;
-			using Token = JsonToken<IntegerType, FloatingType, StringType, BoolType>;
+			using Token = JsonToken<IntegerType, FloatingType, StringTy, BoolType, ObjectPolicyTy>;
+			using StringAllocatorType = typename JsonRebindAllocator<StringType, CharType>::type;
 			static bool _isWhitespace(CharType c) {
 				switch (c) {
 				case static_cast<CharType>(' '):
@@ -1706,22 +3206,36 @@ namespace jjyou {
 					return static_cast<std::size_t>(c);
 				}
 			}
-			JsonLexer(InputAdapter& input) : input(input) {}
+			JsonLexer(InputAdapter& input, const StringAllocatorType& allocator = StringAllocatorType()) : input(input), allocator(allocator), mark(input.rangeBegin) {}
 			Token get(void) {
 				if (!this->ungets.empty()) {
 					Token res = this->ungets.top();
 					this->ungets.pop();
 					return res;
 				}
-				while (!this->input.eof()) {
-					CharType curr = this->input.peek();
-					if (!this->_isWhitespace(curr))
-						break;
-					this->input.get();
-					this->_updateTrace(curr);
+				if (this->input.isRange()) {
+					const CharType* curr = this->input.rangeCurr;
+					if (this->index) {
+						if (curr != this->input.rangeEnd && this->_isWhitespace(*curr))
+							curr = this->input.rangeBegin + this->index->next(static_cast<std::size_t>(curr - this->input.rangeBegin));
+					}
+					else {
+						while (curr != this->input.rangeEnd && this->_isWhitespace(*curr))
+							++curr;
+					}
+					this->input.rangeCurr = curr;
+				}
+				else {
+					while (!this->input.eof()) {
+						CharType curr = this->input.peek();
+						if (!this->_isWhitespace(curr))
+							break;
+						this->input.get();
+						this->_updateTrace(curr);
+					}
 				}
 				if (this->input.eof())
-					return Token(JsonTokenType::End, this->line, this->col, this->pos);
+					return this->_newToken(JsonTokenType::End);
 				CharType curr = this->input.peek();
 				switch (curr) {
 				case static_cast<CharType>('+'):
@@ -1749,7 +3263,8 @@ namespace jjyou {
 							static_cast<CharType>('e')
 						}
 					);
-					res.data.template emplace<3>(static_cast<BoolType>(true));
+					if (res.type == JsonTokenType::Bool)
+						res.data.template emplace<3>(static_cast<BoolType>(true));
 					return res;
 				}
 				case static_cast<CharType>('f'): {
@@ -1762,7 +3277,8 @@ namespace jjyou {
 							static_cast<CharType>('e')
 						}
 					);
-					res.data.template emplace<3>(static_cast<BoolType>(false));
+					if (res.type == JsonTokenType::Bool)
+						res.data.template emplace<3>(static_cast<BoolType>(false));
 					return res;
 				}
 				case static_cast<CharType>('n'):
@@ -1802,7 +3318,10 @@ namespace jjyou {
 			void unget(Token&& token) {
 				this->ungets.push(std::move(token));
 			}
+			// Streams are traced per character. Contiguous inputs are not, see `_locate`.
 			void _updateTrace(CharType c) {
+				if (this->input.isRange())
+					return;
 				if (c == static_cast<CharType>('\n')) {
 					++this->line;
 					this->col = 0ULL;
@@ -1812,149 +3331,284 @@ namespace jjyou {
 				}
 				++this->pos;
 			}
+			// Advance `line` and `col` over [first, last).
+			static void _trace(const CharType* first, const CharType* last, std::size_t& line, std::size_t& col) {
+				const std::size_t newlines = static_cast<std::size_t>(std::count(first, last, static_cast<CharType>('\n')));
+				if (newlines != 0ULL) {
+					line += newlines;
+					auto lastNewline = std::find(std::make_reverse_iterator(last), std::make_reverse_iterator(first), static_cast<CharType>('\n'));
+					col = static_cast<std::size_t>(lastNewline - std::make_reverse_iterator(last));
+				}
+				else {
+					col += static_cast<std::size_t>(last - first);
+				}
+			}
+			// Offset of the next character.
+			std::size_t _pos(void) const {
+				if (this->input.isRange())
+					return this->pos + static_cast<std::size_t>(this->input.rangeCurr - this->mark);
+				return this->pos;
+			}
+			// A token starting at the next character.
+			Token _newToken(JsonTokenType type) const {
+				if (this->input.isRange())
+					return Token(type, 0UL, 0UL, this->_pos());
+				return Token(type, this->line, this->col, this->pos);
+			}
+			// Set the line and column of a token of a contiguous input. Only error messages
+			// need them, so they are counted from `mark` when an error is reported instead
+			// of being traced on every character.
+			void _locate(Token& token) const {
+				if (!this->input.isRange())
+					return;
+				token.line = this->line;
+				token.col = this->col;
+				JsonLexer::_trace(this->mark, this->mark + (token.pos - this->pos), token.line, token.col);
+			}
+			// Move `mark` to the next character, e.g. before the input range is replaced.
+			void _advanceMark(void) {
+				if (!this->input.isRange())
+					return;
+				JsonLexer::_trace(this->mark, this->input.rangeCurr, this->line, this->col);
+				this->pos = this->_pos();
+				this->mark = this->input.rangeCurr;
+			}
+			// The raw text of a token is only needed to report unexpected characters.
+			// Contiguous inputs slice it out of the range afterwards instead of recording it.
+			void _record(StringType& string, CharType c) const {
+				if (!this->input.isRange())
+					string.push_back(c);
+			}
+			StringType _recorded(StringType&& string, const CharType* first) const {
+				if (this->input.isRange())
+					return StringType(first, this->input.rangeCurr);
+				return std::move(string);
+			}
 			Token _forward(JsonTokenType type, std::size_t length, std::optional<StringType> expected) {
-				Token res(type, this->line, this->col, this->pos);
+				Token res = this->_newToken(type);
+				const CharType* first = this->input.rangeCurr;
 				StringType string{};
-				string.reserve(length);
 				for (std::size_t i = 0; i < length; ++i) {
 					if (this->input.eof()) {
 						res.type = JsonTokenType::Unexpected;
-						res.data.template emplace<2>(std::move(string));
+						res.data.template emplace<2>(this->_recorded(std::move(string), first));
 						return res;
 					}
 					CharType curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
+					this->_record(string, curr);
 					if (expected.has_value() && (*expected)[i] != curr) {
 						res.type = JsonTokenType::Unexpected;
-						res.data.template emplace<2>(std::move(string));
+						res.data.template emplace<2>(this->_recorded(std::move(string), first));
 						return res;
 					}
 				}
-				res.data.template emplace<2>(std::move(string));
+				if (type == JsonTokenType::Unexpected)
+					res.data.template emplace<2>(this->_recorded(std::move(string), first));
 				return res;
 			}
+			// Find the extent of the number, then convert it with `std::from_chars`.
+			// The accepted syntax is unchanged: an optional sign, digits with an optional
+			// decimal point, and an optional exponent, which may also have a decimal point.
 			Token _number(void) {
-				Token res(JsonTokenType::Integer, this->line, this->col, this->pos);
+				Token res = this->_newToken(JsonTokenType::Integer);
+				const CharType* first = this->input.rangeCurr;
 				StringType string{};
-				CharType curr{};
-				IntegerType integer = static_cast<IntegerType>(0);
-				FloatingType floating = static_cast<FloatingType>(0.0);
-				constexpr IntegerType baseInteger = static_cast<IntegerType>(10);
-				constexpr FloatingType baseFloating = static_cast<FloatingType>(10.0);
-				bool positive = true;
-				if (this->input.peek() == static_cast<CharType>('-')) {
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
-					positive = false;
-				}
-				else if (this->input.peek() == static_cast<CharType>('+')) {
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
-					positive = true;
-				}
-				std::size_t numBeforeDecimal = 0ULL;
-				while (!this->input.eof() && this->_isDigit(this->input.peek())) {
-					++numBeforeDecimal;
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
-					integer = integer * baseInteger + static_cast<IntegerType>(curr - static_cast<CharType>('0'));
-					floating = floating * baseFloating + static_cast<FloatingType>(curr - static_cast<CharType>('0'));
-				}
+				auto advance = [&](void) -> void {
+					CharType curr = this->input.get(); this->_updateTrace(curr);
+					this->_record(string, curr);
+				};
+				auto digits = [&](void) -> std::size_t {
+					std::size_t count = 0ULL;
+					if (this->input.isRange()) {
+						const CharType* curr = this->input.rangeCurr;
+						while (curr != this->input.rangeEnd && this->_isDigit(*curr))
+							++curr;
+						count = static_cast<std::size_t>(curr - this->input.rangeCurr);
+						this->input.rangeCurr = curr;
+					}
+					else {
+						while (!this->input.eof() && this->_isDigit(this->input.peek())) {
+							++count;
+							advance();
+						}
+					}
+					return count;
+				};
+				if (this->input.peek() == static_cast<CharType>('-') || this->input.peek() == static_cast<CharType>('+'))
+					advance();
+				std::size_t numBeforeDecimal = digits();
 				std::size_t numAfterDecimal = 0ULL;
 				if (!this->input.eof() && this->input.peek() == static_cast<CharType>('.')) {
-					// '.'
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
+					advance();
 					res.type = JsonTokenType::Floating;
-					FloatingType decimal = static_cast<FloatingType>(1.0);
-					while (!this->input.eof() && this->_isDigit(this->input.peek())) {
-						++numAfterDecimal;
-						decimal /= baseFloating;
-						curr = this->input.get(); this->_updateTrace(curr);
-						string.push_back(curr);
-						floating += decimal * static_cast<FloatingType>(curr - static_cast<CharType>('0'));
-					}
+					numAfterDecimal = digits();
 				}
 				if (numBeforeDecimal == 0ULL && numAfterDecimal == 0ULL) {
 					res.type = JsonTokenType::Unexpected;
-					res.data.template emplace<2>(std::move(string));
+					res.data.template emplace<2>(this->_recorded(std::move(string), first));
 					return res;
 				}
-				if (!positive) {
-					integer *= static_cast<IntegerType>(-1);
-					floating *= static_cast<FloatingType>(-1.0);
+				std::size_t exponent = 0ULL;
+				bool fractionalExponent = false;
+				if (!this->input.eof() && (this->input.peek() == static_cast<CharType>('e') || this->input.peek() == static_cast<CharType>('E'))) {
+					res.type = JsonTokenType::Floating;
+					exponent = this->input.isRange() ? static_cast<std::size_t>(this->input.rangeCurr - first) : string.size();
+					advance();
+					if (this->input.eof()) {
+						res.type = JsonTokenType::Unexpected;
+						res.data.template emplace<2>(this->_recorded(std::move(string), first));
+						return res;
+					}
+					if (this->input.peek() == static_cast<CharType>('-') || this->input.peek() == static_cast<CharType>('+'))
+						advance();
+					std::size_t numAfterExponentialBeforeDecimal = digits();
+					std::size_t numAfterExponentialAfterDecimal = 0ULL;
+					if (!this->input.eof() && this->input.peek() == static_cast<CharType>('.')) {
+						advance();
+						numAfterExponentialAfterDecimal = digits();
+						fractionalExponent = true;
+					}
+					if (numAfterExponentialBeforeDecimal == 0ULL && numAfterExponentialAfterDecimal == 0ULL) {
+						res.type = JsonTokenType::Unexpected;
+						res.data.template emplace<2>(this->_recorded(std::move(string), first));
+						return res;
+					}
 				}
-				if (this->input.eof() || (
-					this->input.peek() != static_cast<CharType>('e') && this->input.peek() != static_cast<CharType>('E'))) {
-					if (res.type == JsonTokenType::Integer)
-						res.data.template emplace<0>(integer);
+				const CharType* textBegin = this->input.isRange() ? first : string.data();
+				const CharType* textEnd = this->input.isRange() ? this->input.rangeCurr : string.data() + string.size();
+				if (this->lazyNumbers && this->_isLazy(res.type, textBegin, textEnd, numBeforeDecimal, fractionalExponent)) {
+					if (this->input.isRange())
+						res.data.template emplace<4>(textBegin, textEnd);
 					else
-						res.data.template emplace<1>(floating);
-					return res;
-				}
-				// 'e' or 'E'
-				res.type = JsonTokenType::Floating;
-				curr = this->input.get(); this->_updateTrace(curr);
-				string.push_back(curr);
-				if (this->input.eof()) {
-					res.type = JsonTokenType::Unexpected;
-					res.data.template emplace<2>(std::move(string));
+						res.data.template emplace<2>(std::move(string));
 					return res;
 				}
-				FloatingType exponential = static_cast<FloatingType>(0.0);
-				bool exponentialPositive = true;
-				if (this->input.peek() == static_cast<CharType>('-')) {
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
-					exponentialPositive = false;
+				if constexpr (std::is_same_v<CharType, char>) {
+					this->_convertNumber(res, textBegin, textEnd, exponent ? textBegin + exponent : nullptr, fractionalExponent);
 				}
-				else if (this->input.peek() == static_cast<CharType>('+')) {
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
-					exponentialPositive = true;
+				else {
+					std::string text(static_cast<std::size_t>(textEnd - textBegin), '\0');
+					std::transform(textBegin, textEnd, text.begin(), [](CharType c) -> char { return static_cast<char>(c); });
+					this->_convertNumber(res, text.data(), text.data() + text.size(), exponent ? text.data() + exponent : nullptr, fractionalExponent);
 				}
-				std::size_t numAfterExponentialBeforeDecimal = 0ULL;
-				while (!this->input.eof() && this->_isDigit(this->input.peek())) {
-					++numAfterExponentialBeforeDecimal;
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
-					exponential = exponential * baseFloating + static_cast<FloatingType>(curr - static_cast<CharType>('0'));
+				return res;
+			}
+			// Whether a number can be kept as text. Its text must be valid standard json,
+			// so that it can be written back unchanged, and an integer must fit `IntegerType`.
+			static bool _isLazy(JsonTokenType type, const CharType* first, const CharType* last, std::size_t numBeforeDecimal, bool fractionalExponent) {
+				if (*first == static_cast<CharType>('+') || numBeforeDecimal == 0ULL || fractionalExponent)
+					return false;
+				const CharType* digits = first + (*first == static_cast<CharType>('-'));
+				if (numBeforeDecimal > 1ULL && *digits == static_cast<CharType>('0'))
+					return false;
+				const CharType* point = std::find(digits, last, static_cast<CharType>('.'));
+				if (point != last && (point + 1 == last || !JsonLexer::_isDigit(point[1])))
+					return false;
+				if (type == JsonTokenType::Integer) {
+					if constexpr (std::is_integral_v<IntegerType>)
+						return numBeforeDecimal < static_cast<std::size_t>(std::numeric_limits<IntegerType>::digits10);
+					else
+						return false;
 				}
-				std::size_t numAfterExponentialAfterDecimal = 0ULL;
-				if (!this->input.eof() && this->input.peek() == static_cast<CharType>('.')) {
-					// '.'
-					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
-					FloatingType decimal = static_cast<FloatingType>(1.0);
-					while (!this->input.eof() && this->_isDigit(this->input.peek())) {
-						++numAfterExponentialAfterDecimal;
-						decimal /= baseFloating;
-						curr = this->input.get(); this->_updateTrace(curr);
-						string.push_back(curr);
-						exponential += decimal * static_cast<FloatingType>(curr - static_cast<CharType>('0'));
+				return true;
+			}
+			// `first` and `last` hold a number accepted by `_number`. `exponent` points to
+			// the 'e' or 'E' if there is one.
+			static void _convertNumber(Token& res, const char* first, const char* last, const char* exponent, bool fractionalExponent) {
+				// `std::from_chars` does not accept a leading '+'.
+				if (*first == '+')
+					++first;
+				if (res.type == JsonTokenType::Integer) {
+					if constexpr (std::is_integral_v<IntegerType>) {
+						IntegerType integer{};
+						std::from_chars_result conversion = std::from_chars(first, last, integer);
+						if (conversion.ec == std::errc()) {
+							res.data.template emplace<0>(integer);
+							return;
+						}
 					}
+					else {
+						long long integer = 0LL;
+						std::from_chars_result conversion = std::from_chars(first, last, integer);
+						if (conversion.ec == std::errc()) {
+							res.data.template emplace<0>(static_cast<IntegerType>(integer));
+							return;
+						}
+					}
+					// Out of the range of `IntegerType`. Keep the value as a floating point.
+					res.type = JsonTokenType::Floating;
+					res.overflow = true;
 				}
-				if (numAfterExponentialBeforeDecimal == 0ULL && numAfterExponentialAfterDecimal == 0ULL) {
-					res.type = JsonTokenType::Unexpected;
-					res.data.template emplace<2>(std::move(string));
-					return res;
+				if (fractionalExponent) {
+					// Non-standard exponents such as "1e2.5" are evaluated with `std::pow`.
+					FloatingType mantissa = JsonLexer::_toFloating(first, exponent);
+					FloatingType power = JsonLexer::_toFloating(exponent + 1 + (exponent[1] == '+'), last);
+					res.data.template emplace<1>(mantissa * std::pow(static_cast<FloatingType>(10.0), power));
+					return;
 				}
-				if (!exponentialPositive) {
-					exponential *= static_cast<FloatingType>(-1.0);
+				res.data.template emplace<1>(JsonLexer::_toFloating(first, last));
+			}
+			static FloatingType _toFloating(const char* first, const char* last) {
+				using ConversionType = std::conditional_t<std::is_floating_point_v<FloatingType>, FloatingType, double>;
+				ConversionType floating{};
+				std::from_chars_result conversion = std::from_chars(first, last, floating);
+				if (conversion.ec == std::errc::result_out_of_range) {
+					// Overflow gives infinity, underflow gives zero, as with `std::strtod`.
+					const bool negative = (*first == '-');
+					const char* mantissa = first + negative;
+					const char* mantissaEnd = std::find_if(mantissa, last, [](char c) -> bool { return c == 'e' || c == 'E'; });
+					const char* point = std::find(mantissa, mantissaEnd, '.');
+					const char* nonzero = std::find_if(mantissa, mantissaEnd, [](char c) -> bool { return c >= '1' && c <= '9'; });
+					long long magnitude = (nonzero < point) ? static_cast<long long>(point - nonzero) : -static_cast<long long>(nonzero - point);
+					if (mantissaEnd != last) {
+						long long power = 0LL;
+						const char* powerBegin = mantissaEnd + 1 + (mantissaEnd[1] == '+');
+						if (std::from_chars(powerBegin, last, power).ec == std::errc::result_out_of_range)
+							power = (*powerBegin == '-') ? std::numeric_limits<long long>::min() / 2 : std::numeric_limits<long long>::max() / 2;
+						magnitude += power;
+					}
+					floating = (magnitude > 0) ? std::numeric_limits<ConversionType>::infinity() : static_cast<ConversionType>(0.0);
+					if (negative)
+						floating = -floating;
 				}
-				res.data.template emplace<1>(floating * std::pow<FloatingType>(baseFloating, exponential));
-				return res;
+				return static_cast<FloatingType>(floating);
 			}
 			Token _string(void) {
 				StringType string{};
-				StringType value{};
+				StringType value = this->_newString();
 				bool findEnd = false;
-				Token res(JsonTokenType::String, this->line, this->col, this->pos);
+				Token res = this->_newToken(JsonTokenType::String);
+				const CharType* first = this->input.rangeCurr;
 				CharType curr = this->input.get(); this->_updateTrace(curr); // '\"'
-				string.push_back(curr);
+				this->_record(string, curr);
 				while (!this->input.eof()) {
+					if (this->input.isRange()) {
+						// Copy the run of plain characters in one go.
+						const CharType* runBegin = this->input.rangeCurr;
+						const CharType* runEnd = runBegin;
+						if constexpr (sizeof(CharType) == 1) {
+							runEnd = reinterpret_cast<const CharType*>(JsonStructuralIndex::_findQuoteOrBackslash(
+								reinterpret_cast<const char*>(runBegin),
+								reinterpret_cast<const char*>(this->input.rangeEnd)
+							));
+						}
+						else {
+							while (runEnd != this->input.rangeEnd && *runEnd != static_cast<CharType>('\"') && *runEnd != static_cast<CharType>('\\'))
+								++runEnd;
+						}
+						if (runBegin == first + 1 && runEnd != this->input.rangeEnd && *runEnd == static_cast<CharType>('\"')) {
+							// No escape sequences. Refer to the input instead of copying.
+							this->input.rangeCurr = runEnd + 1;
+							res.data.template emplace<4>(runBegin, static_cast<std::size_t>(runEnd - runBegin));
+							return res;
+						}
+						value.append(runBegin, runEnd);
+						this->input.rangeCurr = runEnd;
+						if (runEnd == this->input.rangeEnd)
+							break;
+					}
 					curr = this->input.get(); this->_updateTrace(curr);
-					string.push_back(curr);
+					this->_record(string, curr);
 					if (curr == '\"') {
 						findEnd = true;
 						break;
@@ -1962,11 +3616,11 @@ namespace jjyou {
 					else if (curr == '\\') {
 						if (this->input.eof()) {
 							res.type = JsonTokenType::Unexpected;
-							res.data.template emplace<2>(std::move(string));
+							res.data.template emplace<2>(this->_recorded(std::move(string), first));
 							return res;
 						}
 						curr = this->input.get(); this->_updateTrace(curr);
-						string.push_back(curr);
+						this->_record(string, curr);
 						switch (curr) {
 						case static_cast<CharType>('\"'):
 						case static_cast<CharType>('\\'):
@@ -1993,14 +3647,14 @@ namespace jjyou {
 							for (std::size_t i = 0; i < 4; ++i) {
 								if (this->input.eof()) {
 									res.type = JsonTokenType::Unexpected;
-									res.data.template emplace<2>(std::move(string));
+									res.data.template emplace<2>(this->_recorded(std::move(string), first));
 									return res;
 								}
 								hex[i] = this->input.get(); this->_updateTrace(hex[i]);
-								string.push_back(hex[i]);
+								this->_record(string, hex[i]);
 								if (!this->_isHex(hex[i])) {
 									res.type = JsonTokenType::Unexpected;
-									res.data.template emplace<2>(std::move(string));
+									res.data.template emplace<2>(this->_recorded(std::move(string), first));
 									return res;
 								}
 							}
@@ -2015,7 +3669,7 @@ namespace jjyou {
 						}
 						default:
 							res.type = JsonTokenType::Unexpected;
-							res.data.template emplace<2>(std::move(string));
+							res.data.template emplace<2>(this->_recorded(std::move(string), first));
 							return res;
 						}
 					}
@@ -2028,127 +3682,683 @@ namespace jjyou {
 				}
 				else {
 					res.type = JsonTokenType::Unexpected;
-					res.data.template emplace<2>(std::move(string));
+					res.data.template emplace<2>(this->_recorded(std::move(string), first));
 				}
 				return res;
 			}
+			StringType _newString(void) const {
+				if constexpr (std::is_constructible_v<StringType, const StringAllocatorType&>)
+					return StringType(this->allocator);
+				else
+					return StringType();
+			}
 			InputAdapter& input;
+			StringAllocatorType allocator{};
+			JsonStructuralIndex* index = nullptr;
+			bool lazyNumbers = false;
+			std::size_t maxDepth = std::numeric_limits<std::size_t>::max();
+			// Trace of the next character for streams. For contiguous inputs, trace of `mark`,
+			// a character before the next one (see `_locate`).
 			std::size_t line = 0UL;
 			std::size_t col = 0UL;
 			std::size_t pos = 0UL;
+			const CharType* mark = nullptr;
 			std::stack<Token> ungets{};
-			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy>;
+			friend class Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend class JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			friend class JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			template <class _JsonTy>
+			friend class JsonBinder;
 		};
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy> template <class T>
-		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy>::parse(T&& src) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_lazyNumber(JsonType type, std::basic_string_view<CharType> text) {
+			Json res;
+			if (text.size() > _Raw::capacity) {
+				Token token = Json::_convertNumber(type, text);
+				if (token.type == JsonTokenType::Integer)
+					res = Json(std::get<0>(token.data));
+				else
+					res = Json(std::get<1>(token.data));
+				return res;
+			}
+			new (&res._raw) _Raw;
+			std::copy(text.begin(), text.end(), res._raw.text);
+			res._raw.size = static_cast<unsigned char>(text.size());
+			res._lazy = true;
+			res._type = type;
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::Token Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_convertNumber(JsonType type, std::basic_string_view<CharType> text) {
+			Token token(type == JsonType::Integer ? JsonTokenType::Integer : JsonTokenType::Floating, 0U, 0U, 0U);
+			if constexpr (std::is_same_v<CharType, char>) {
+				Lexer::_convertNumber(token, text.data(), text.data() + text.size(), nullptr, false);
+			}
+			else {
+				std::string narrow(text.size(), '\0');
+				std::transform(text.begin(), text.end(), narrow.begin(), [](CharType c) -> char { return static_cast<char>(c); });
+				Lexer::_convertNumber(token, narrow.data(), narrow.data() + narrow.size(), nullptr, false);
+			}
+			return token;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_decode(void) const {
+			if (!this->_lazy)
+				return;
+			Token token = Json::_convertNumber(this->_type, std::basic_string_view<CharType>(this->_raw.text, this->_raw.size));
+			// The lexer only keeps integers as text if they fit `IntegerType`, so the type does not change.
+			this->_lazy = false;
+			if (this->_type == JsonType::Integer)
+				new (&this->_integer) IntegerType(std::get<0>(token.data));
+			else
+				new (&this->_floating) FloatingType(std::get<1>(token.data));
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_unpack(void) {
+			if (this->_packed == _Packing::None)
+				return;
+			// Build the elements first, so that the packed array is kept if it throws.
+			// Reuse the elements built by const accesses, if any.
+			ArrayType* elements = (this->_packed == _Packing::Integer) ? this->_integers.elements.load() : this->_floatings.elements.load();
+			ArrayType array = elements ? std::move(*elements) : this->_packedElements();
+			if (this->_packed == _Packing::Integer)
+				this->_integers.~_PackedIntegers();
+			else
+				this->_floatings.~_PackedFloatings();
+			this->_packed = _Packing::None;
+			new (&this->_array) ArrayType(std::move(array));
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::ArrayType Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_packedElements(void) const {
+			ArrayType array = (this->_packed == _Packing::Integer) ? ArrayType(AllocatorType(this->_integers.get_allocator())) : ArrayType(AllocatorType(this->_floatings.get_allocator()));
+			array.reserve(this->size());
+			if (this->_packed == _Packing::Integer) {
+				for (const IntegerType& number : this->_integers)
+					array.emplace_back(number);
+			}
+			else {
+				for (const FloatingType& number : this->_floatings)
+					array.emplace_back(number);
+			}
+			return array;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline const typename Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::ArrayType& Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_elements(void) const {
+			if (this->_packed == _Packing::None)
+				return this->_array;
+			std::atomic<ArrayType*>& elements = (this->_packed == _Packing::Integer) ? this->_integers.elements : this->_floatings.elements;
+			if (ArrayType* res = elements.load(std::memory_order_acquire))
+				return *res;
+			// Concurrent first accesses may both build the elements. One of them is published.
+			std::unique_ptr<ArrayType> built = std::make_unique<ArrayType>(this->_packedElements());
+			ArrayType* expected = nullptr;
+			if (elements.compare_exchange_strong(expected, built.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+				return *built.release();
+			return *expected;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline std::vector<T> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_packedVector(void) const {
+			if constexpr (std::is_arithmetic_v<T>) {
+				if (this->_packed == _Packing::Integer)
+					return std::vector<T>(this->_integers.begin(), this->_integers.end());
+				return std::vector<T>(this->_floatings.begin(), this->_floatings.end());
+			}
+			else {
+				std::vector<T> res; res.reserve(this->size());
+				if (this->_packed == _Packing::Integer) {
+					for (const IntegerType& number : this->_integers)
+						res.emplace_back(Json(number));
+				}
+				else {
+					for (const FloatingType& number : this->_floatings)
+						res.emplace_back(Json(number));
+				}
+				return res;
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::element(size_type pos) const {
+			if (this->_type != JsonType::Array)
+				throw std::out_of_range("`Json Json::element(size_type) const` is valid only if the Json container is an array.");
+			if (pos >= this->size())
+				throw std::out_of_range("`Json Json::element(size_type) const` got an index out of range.");
+			if (this->_packed == _Packing::Integer)
+				return Json(this->_integers[pos]);
+			if (this->_packed == _Packing::Floating)
+				return Json(this->_floatings[pos]);
+			return this->_array[pos];
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::pack(void) {
+			if (this->_type != JsonType::Array)
+				throw std::out_of_range("`bool Json::pack()` is valid only if the Json container is an array.");
+			if (this->_packed != _Packing::None)
+				return true;
+			if (this->_array.empty())
+				return false;
+			const JsonType type = this->_array.front()._type;
+			if (type != JsonType::Integer && type != JsonType::Floating)
+				return false;
+			for (const Json& element : this->_array)
+				if (element._type != type)
+					return false;
+			// The elements are numbers, so the hash does not change.
+			if (type == JsonType::Integer) {
+				IntegerArrayType numbers(typename IntegerArrayType::allocator_type(this->_array.get_allocator()));
+				numbers.reserve(this->_array.size());
+				for (const Json& element : this->_array)
+					numbers.push_back(element.integer());
+				this->_array.~ArrayType();
+				new (&this->_integers) _PackedIntegers(std::move(numbers));
+				this->_packed = _Packing::Integer;
+			}
+			else {
+				FloatingArrayType numbers(typename FloatingArrayType::allocator_type(this->_array.get_allocator()));
+				numbers.reserve(this->_array.size());
+				for (const Json& element : this->_array)
+					numbers.push_back(element.floating());
+				this->_array.~ArrayType();
+				new (&this->_floatings) _PackedFloatings(std::move(numbers));
+				this->_packed = _Packing::Floating;
+			}
+			return true;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::parse(T&& src) {
+			return Json::parse(std::forward<T>(src), ParseOptions{});
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::parse(T&& src, const ParseOptions& options) {
+			return Json::parse(std::forward<T>(src), options, AllocatorType());
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::parse(T&& src, const AllocatorType& allocator) {
+			return Json::parse(std::forward<T>(src), ParseOptions{}, allocator);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::parse(T&& src, const ParseOptions& options, const AllocatorType& allocator) {
 			InputAdapter inputAdapter(std::forward<T>(src));
-			Lexer lexer(inputAdapter);
-			return Json::_parse(lexer);
+			if constexpr (std::allocator_traits<AllocatorType>::is_always_equal::value) {
+				if (options.threads != 1 && inputAdapter.isRange() && static_cast<std::size_t>(inputAdapter.rangeEnd - inputAdapter.rangeBegin) >= options.parallelThreshold) {
+					Json res;
+					if (Json::_parseParallel(inputAdapter.rangeBegin, inputAdapter.rangeEnd, options, allocator, res))
+						return res;
+				}
+			}
+			JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> builder(allocator);
+			builder.pack(options.packNumbers, options.packedKeys);
+			Json::_sax(inputAdapter, builder, options, allocator);
+			return builder.release();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::parse(T&& src, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy> {
+			return Json::parse(std::forward<T>(src), ParseOptions{}, arena);
 		}
 
-		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy>
-		Json<IntegerTy, FloatingTy, StringTy, BoolTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy>::_parse(Lexer& lexer) {
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::parse(T&& src, const ParseOptions& options, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy> {
+			InputAdapter inputAdapter(std::forward<T>(src));
+			// Buffers owned by the adapter (moved-in strings, mapped files) die with it.
+			bool borrowed = inputAdapter.isRange() && !inputAdapter.owner;
+			JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> builder(
+				arena,
+				borrowed ? inputAdapter.rangeBegin : nullptr,
+				borrowed ? inputAdapter.rangeEnd : nullptr
+			);
+			builder.pack(options.packNumbers, options.packedKeys);
+			Json::_sax(inputAdapter, builder, options, AllocatorType());
+			return builder.release();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::fromCBOR(std::span<const std::uint8_t> data, const AllocatorType& allocator) {
+			JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> builder(allocator);
+			return Json::_fromBinary(data, JsonBinaryFormat::CBOR, builder);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::fromCBOR(std::span<const std::uint8_t> data, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy> {
+			const CharType* first = reinterpret_cast<const CharType*>(data.data());
+			JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> builder(arena, first, first + data.size());
+			return Json::_fromBinary(data, JsonBinaryFormat::CBOR, builder);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::fromMsgPack(std::span<const std::uint8_t> data, const AllocatorType& allocator) {
+			JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> builder(allocator);
+			return Json::_fromBinary(data, JsonBinaryFormat::MsgPack, builder);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::fromMsgPack(std::span<const std::uint8_t> data, JsonStringArena<CharType>& arena) requires JsonIsStringView<StringTy> {
+			const CharType* first = reinterpret_cast<const CharType*>(data.data());
+			JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> builder(arena, first, first + data.size());
+			return Json::_fromBinary(data, JsonBinaryFormat::MsgPack, builder);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class BuilderTy>
+		inline Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_fromBinary(std::span<const std::uint8_t> data, JsonBinaryFormat format, BuilderTy& builder) {
+			JsonBinaryReader<IntegerTy, FloatingTy, CharType> reader(data, format);
+			reader.read(builder);
+			if (reader.position() != data.size())
+				throw std::runtime_error(std::string(format == JsonBinaryFormat::CBOR ? "[Json CBOR] pos:" : "[Json MsgPack] pos:") + std::to_string(reader.position() + 1) + " Unexpected data after the value.");
+			return builder.release();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T, class HandlerTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::sax(T&& src, HandlerTy& handler) {
+			Json::_sax(std::forward<T>(src), handler, ParseOptions{}, AllocatorType());
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T, class HandlerTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::sax(T&& src, HandlerTy& handler, const ParseOptions& options) {
+			Json::_sax(std::forward<T>(src), handler, options, AllocatorType());
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T, class HandlerTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_sax(T&& src, HandlerTy& handler, const ParseOptions& options, const AllocatorType& allocator) {
+			InputAdapter inputAdapter(std::forward<T>(src));
+			Json::_sax(inputAdapter, handler, options, allocator);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class HandlerTy>
+		inline void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_sax(InputAdapter& inputAdapter, HandlerTy& handler, const ParseOptions& options, const AllocatorType& allocator) {
+			Lexer lexer(inputAdapter, allocator);
+			if constexpr (requires(std::basic_string_view<CharType> text) { handler.onRawInteger(text); handler.onRawFloating(text); })
+				lexer.lazyNumbers = options.lazyNumbers;
+			lexer.maxDepth = options.maxDepth;
+			std::unique_ptr<JsonStructuralIndex> index{};
+			if constexpr (sizeof(CharType) == 1) {
+				if (options.structuralIndex && inputAdapter.isRange()) {
+					index.reset(new JsonStructuralIndex(
+						reinterpret_cast<const char*>(inputAdapter.rangeBegin),
+						reinterpret_cast<const char*>(inputAdapter.rangeEnd)
+					));
+					lexer.index = index.get();
+				}
+			}
+			Json::_sax(lexer, handler);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class HandlerTy>
+		void Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_sax(Lexer& lexer, HandlerTy& handler) {
 			// For throwing exceptions
-			auto error = []<class... Args>(const Token & token, Args&&... args) {
+			auto error = [&lexer]<class... Args>(Token token, Args&&... args) {
+				lexer._locate(token);
 				std::basic_stringstream<CharType> sstream;
 				sstream << "[Json Parser] ln:" << (token.line + 1U) << ", col:" << (token.col + 1U) << ", pos:" << (token.pos + 1U) << " ";
 				((sstream << std::forward<Args>(args)), ...);
 				throw std::runtime_error(InputAdapter::_toStdString(sstream.str()));
 			};
+			auto unexpected = [&error](const Token& token) -> void {
+				if (token.type == JsonTokenType::End)
+					error(token, "Unexpected EOF.");
+				if (token.type == JsonTokenType::Unexpected)
+					error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
+			};
+			// Read a key and its colon, starting at `token`, and the first token of the value.
+			auto member = [&](Token& token) -> void {
+				unexpected(token);
+				if (token.type != JsonTokenType::String)
+					error(token, "Object's key must be a string.");
+				handler.onKey(token.view());
+				token = lexer.get();
+				unexpected(token);
+				if (token.type != JsonTokenType::Colon)
+					error(token, "Missing colon to separate key and value.");
+				token = lexer.get();
+			};
+			// Open arrays and objects, innermost last. The loop parses one value per
+			// iteration, so the call stack does not grow with the nesting depth.
+			std::vector<JsonTokenType> stack{};
 			Token token = lexer.get();
-			switch (token.type) {
-			case JsonTokenType::Null:/* Null */
-			{
-				Json json{};
-				return json;
+			while (true) {
+				switch (token.type) {
+				case JsonTokenType::Null:/* Null */
+				{
+					handler.onNull();
+					break;
+				}
+				case JsonTokenType::Integer:/* Integer */
+				{
+					if constexpr (requires { handler.onRawInteger(token.view()); }) {
+						if (token.data.index() != 0) {
+							handler.onRawInteger(token.view());
+							break;
+						}
+					}
+					handler.onInteger(std::get<0>(token.data));
+					break;
+				}
+				case JsonTokenType::Floating:/* Floating */
+				{
+					if constexpr (requires { handler.onRawFloating(token.view()); }) {
+						if (token.data.index() != 1) {
+							handler.onRawFloating(token.view());
+							break;
+						}
+					}
+					handler.onFloating(std::get<1>(token.data));
+					break;
+				}
+				case JsonTokenType::String:/* String */
+				{
+					handler.onString(token.view());
+					break;
+				}
+				case JsonTokenType::Bool:/* Bool */
+				{
+					handler.onBool(std::get<3>(token.data));
+					break;
+				}
+				case JsonTokenType::Lbracket: /* Array */
+				{
+					if (stack.size() >= lexer.maxDepth)
+						error(token, "Maximum nesting depth exceeded.");
+					handler.onStartArray();
+					token = lexer.get();
+					if (token.type != JsonTokenType::Rbracket) {
+						stack.push_back(JsonTokenType::Lbracket);
+						continue;
+					}
+					handler.onEndArray();
+					break;
+				}
+				case JsonTokenType::Lbrace: /* Object */
+				{
+					if (stack.size() >= lexer.maxDepth)
+						error(token, "Maximum nesting depth exceeded.");
+					handler.onStartObject();
+					token = lexer.get();
+					if (token.type != JsonTokenType::Rbrace) {
+						stack.push_back(JsonTokenType::Lbrace);
+						member(token);
+						continue;
+					}
+					handler.onEndObject();
+					break;
+				}
+				case JsonTokenType::End:
+				case JsonTokenType::Unexpected:
+				{
+					unexpected(token);
+					break;
+				}
+				default:
+				{
+					// Punctuation where a value is expected, e.g. "[1,]".
+					CharType c = static_cast<CharType>(',');
+					switch (token.type) {
+					case JsonTokenType::Colon: c = static_cast<CharType>(':'); break;
+					case JsonTokenType::Rbracket: c = static_cast<CharType>(']'); break;
+					case JsonTokenType::Rbrace: c = static_cast<CharType>('}'); break;
+					default: break;
+					}
+					error(token, "Unexpected characters \"", c, "\".");
+				}
+				}
+				// A value is complete. Close the containers it completes and move to the next value.
+				while (true) {
+					if (stack.empty())
+						return;
+					token = lexer.get();
+					unexpected(token);
+					if (stack.back() == JsonTokenType::Lbracket) {
+						if (token.type == JsonTokenType::Comma) {
+							token = lexer.get();
+							break;
+						}
+						if (token.type != JsonTokenType::Rbracket)
+							error(token, "Missing comma to separate elements in an array.");
+						handler.onEndArray();
+					}
+					else {
+						if (token.type == JsonTokenType::Comma) {
+							token = lexer.get();
+							member(token);
+							break;
+						}
+						if (token.type != JsonTokenType::Rbrace)
+							error(token, "Missing comma to separate elements in an object.");
+						handler.onEndObject();
+					}
+					stack.pop_back();
+				}
 			}
-			case JsonTokenType::Integer:/* Integer */
-			{
-				Json json(std::get<0>(token.data));
-				return json;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		bool Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_parseParallel(const CharType* first, const CharType* last, const ParseOptions& options, const AllocatorType& allocator, Json& res) {
+			std::size_t numThreads = options.threads;
+			if (numThreads == 0)
+				numThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+			// The sequential parser reports a top-level array that is already too deep.
+			if (numThreads <= 1 || options.maxDepth == 0)
+				return false;
+			// Pre-scan: find the top-level commas of the array, skipping strings and counting brackets.
+			// Brackets are not matched here; malformed input makes a chunk fail to parse.
+			const CharType* curr = first;
+			while (curr != last && Lexer::_isWhitespace(*curr))
+				++curr;
+			if (curr == last || *curr != static_cast<CharType>('['))
+				return false;
+			++curr;
+			const std::size_t chunkSize = std::max<std::size_t>(static_cast<std::size_t>(last - first) / (numThreads * 8), 1);
+			std::vector<std::pair<const CharType*, const CharType*>> chunks;
+			const CharType* chunkBegin = curr;
+			std::size_t depth = 0;
+			bool closed = false;
+			for (; curr != last && !closed; ++curr) {
+				switch (*curr) {
+				case static_cast<CharType>('\"'):
+					for (++curr; curr != last && *curr != static_cast<CharType>('\"'); ++curr) {
+						if (*curr == static_cast<CharType>('\\') && ++curr == last)
+							return false;
+					}
+					if (curr == last)
+						return false;
+					break;
+				case static_cast<CharType>('['):
+				case static_cast<CharType>('{'):
+					++depth;
+					break;
+				case static_cast<CharType>(']'):
+				case static_cast<CharType>('}'):
+					if (depth == 0)
+						closed = true;
+					else
+						--depth;
+					break;
+				case static_cast<CharType>(','):
+					if (depth == 0 && static_cast<std::size_t>(curr - chunkBegin) >= chunkSize) {
+						chunks.emplace_back(chunkBegin, curr);
+						chunkBegin = curr + 1;
+					}
+					break;
+				default:
+					break;
+				}
 			}
-			case JsonTokenType::Floating:/* Floating */
+			if (!closed || *(--curr) != static_cast<CharType>(']') || chunks.empty())
+				return false;
+			chunks.emplace_back(chunkBegin, curr);
+			// Parse each chunk, a comma-separated list of elements, into an array.
+			// If every chunk is a valid list, the whole input is the array of all their elements.
+			std::vector<Json> parts(chunks.size());
+			std::atomic<std::size_t> next = 0;
+			std::atomic<bool> failed = false;
+			auto work = [&](void) -> void {
+				for (std::size_t index = next++; index < chunks.size() && !failed; index = next++) {
+					try {
+						InputAdapter inputAdapter(chunks[index].first, chunks[index].second);
+						Lexer lexer(inputAdapter, allocator);
+						lexer.lazyNumbers = options.lazyNumbers;
+						// Elements of the top-level array start at depth 2.
+						lexer.maxDepth = (options.maxDepth == 0) ? 0 : options.maxDepth - 1;
+						std::unique_ptr<JsonStructuralIndex> structuralIndex{};
+						if constexpr (sizeof(CharType) == 1) {
+							if (options.structuralIndex) {
+								structuralIndex.reset(new JsonStructuralIndex(
+									reinterpret_cast<const char*>(chunks[index].first),
+									reinterpret_cast<const char*>(chunks[index].second)
+								));
+								lexer.index = structuralIndex.get();
+							}
+						}
+						JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> builder(allocator);
+						builder.pack(options.packNumbers, options.packedKeys);
+						builder.onStartArray();
+						while (true) {
+							Json::_sax(lexer, builder);
+							JsonTokenType type = lexer.get().type;
+							if (type == JsonTokenType::End)
+								break;
+							if (type != JsonTokenType::Comma)
+								throw std::runtime_error("[Json Parser] Missing comma to separate elements in an array.");
+						}
+						builder.onEndArray();
+						parts[index] = builder.release();
+					}
+					catch (...) {
+						failed = true;
+					}
+				}
+			};
 			{
-				Json json(std::get<1>(token.data));
-				return json;
+				std::vector<std::jthread> workers;
+				workers.reserve(std::min(numThreads, chunks.size()));
+				for (std::size_t i = 0; i < std::min(numThreads, chunks.size()); ++i)
+					workers.emplace_back(work);
 			}
-			case JsonTokenType::String:/* String */
-			{
-				Json json(std::get<2>(token.data));
-				return json;
+			if (failed)
+				return false;
+			std::size_t size = 0;
+			for (const Json& part : parts)
+				size += part.size();
+			// The parts of a packed array are packed alike, unless their numbers are mixed.
+			if (std::all_of(parts.begin(), parts.end(), [&parts](const Json& part) -> bool { return part._packed != _Packing::None && part._packed == parts.front()._packed; })) {
+				res = std::move(parts.front());
+				if (res._packed == _Packing::Integer) {
+					res._integers.reserve(size);
+					for (std::size_t i = 1; i < parts.size(); ++i)
+						res._integers.insert(res._integers.end(), parts[i]._integers.begin(), parts[i]._integers.end());
+				}
+				else {
+					res._floatings.reserve(size);
+					for (std::size_t i = 1; i < parts.size(); ++i)
+						res._floatings.insert(res._floatings.end(), parts[i]._floatings.begin(), parts[i]._floatings.end());
+				}
+				return true;
 			}
-			case JsonTokenType::Bool:/* Bool */
-			{
-				Json json(std::get<3>(token.data));
-				return json;
+			for (Json& part : parts)
+				part._unpack();
+			res = Json(JsonType::Array, allocator);
+			res._array.reserve(size);
+			for (Json& part : parts)
+				for (Json& element : part._array)
+					res._array.push_back(std::move(element));
+			return true;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline StringTy JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_newString(StringViewType string) const {
+			if constexpr (JsonIsStringView<StringTy>) {
+				std::less_equal<const CharType*> lessEqual;
+				if (lessEqual(this->first, string.data()) && lessEqual(string.data() + string.size(), this->last))
+					return StringTy(string.data(), string.size());
+				StringViewType stored = this->arena->store(string);
+				return StringTy(stored.data(), stored.size());
 			}
-			case JsonTokenType::Lbracket: /* Array */
-			{
-				Json json(JsonType::Array);
-				while ((token = lexer.peek()).type != JsonTokenType::Rbracket) {
-					if (token.type == JsonTokenType::End)
-						error(token, "Unexpected EOF.");
-					if (token.type == JsonTokenType::Unexpected)
-						error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
-					if (!json._array.empty()) {
-						lexer.get();
-						if (token.type != JsonTokenType::Comma)
-							error(token, "Missing comma to separate elements in an array.");
-					}
-					json._array.push_back(Json::_parse(lexer));
+			else if constexpr (std::is_constructible_v<StringTy, const CharType*, std::size_t, const StringAllocatorType&>)
+				return StringTy(string.data(), string.size(), StringAllocatorType(this->allocator));
+			else
+				return StringTy(string.data(), string.size());
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_packable(void) const {
+			if (this->packAll)
+				return true;
+			// A new array is the value of the last key if its parent is an object.
+			if (this->packedKeys.empty() || this->stack.empty() || this->stack.back()._type != JsonType::Object)
+				return false;
+			StringViewType key(this->keys.back().data(), this->keys.back().size());
+			return std::any_of(this->packedKeys.begin(), this->packedKeys.end(), [&key](const auto& packedKey) -> bool {
+				return StringViewType(packedKey.data(), packedKey.size()) == key;
+			});
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_pack(DomType& array, DomType& json) {
+			using Packing = typename DomType::_Packing;
+			json._decode();
+			if (array._packed == Packing::None) {
+				// The first element decides the type of the numbers.
+				if (json._type == JsonType::Integer) {
+					std::destroy_at(&array._array);
+					new (&array._integers) typename DomType::_PackedIntegers(this->allocator);
+					array._packed = Packing::Integer;
+				}
+				else if (json._type == JsonType::Floating) {
+					std::destroy_at(&array._array);
+					new (&array._floatings) typename DomType::_PackedFloatings(this->allocator);
+					array._packed = Packing::Floating;
+				}
+				else {
+					this->packing.back() = false;
+					return false;
 				}
-				lexer.get();
-				return json;
 			}
-			case JsonTokenType::Lbrace: /* Object */
-			{
-				Json json(JsonType::Object);
-				while ((token = lexer.peek()).type != JsonTokenType::Rbrace) {
-					if (token.type == JsonTokenType::End)
-						error(token, "Unexpected EOF.");
-					if (token.type == JsonTokenType::Unexpected)
-						error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
-					if (!json._object.empty()) {
-						token = lexer.get();
-						if (token.type == JsonTokenType::End)
-							error(token, "Unexpected EOF.");
-						if (token.type == JsonTokenType::Unexpected)
-							error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
-						if (token.type != JsonTokenType::Comma)
-							error(token, "Missing comma to separate elements in an object.");
-					}
-					token = lexer.get(); // Key
-					if (token.type == JsonTokenType::End)
-						error(token, "Unexpected EOF.");
-					if (token.type == JsonTokenType::Unexpected)
-						error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
-					if (token.type != JsonTokenType::String)
-						error(token, "Object's key must be a string.");
-					StringType key = std::get<2>(token.data);
-					token = lexer.get();
-					if (token.type == JsonTokenType::End)
-						error(token, "Unexpected EOF.");
-					if (token.type == JsonTokenType::Unexpected)
-						error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
-					if (token.type != JsonTokenType::Colon)
-						error(token, "Missing colon to separate key and value.");
-					json._object.emplace(key, Json::_parse(lexer));
-				}
-				lexer.get();
-				return json;
-			}
-			case JsonTokenType::End:
-			{
-				error(token, "Unexpected EOF.");
+			if (array._packed == Packing::Integer && json._type == JsonType::Integer) {
+				array._integers.push_back(json._integer);
+				return true;
 			}
-			case JsonTokenType::Unexpected:
-			default:
-			{
-				error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
+			if (array._packed == Packing::Floating && json._type == JsonType::Floating) {
+				array._floatings.push_back(json._floating);
+				return true;
+			}
+			// Mixed numbers are kept as they are, to be written back unchanged.
+			array._unpack();
+			this->packing.back() = false;
+			return false;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_value(DomType&& json) {
+			if (this->stack.empty()) {
+				this->root = std::move(json);
+				return;
+			}
+			DomType& parent = this->stack.back();
+			if (parent._type == JsonType::Array) {
+				if (!this->packing.back() || !this->_pack(parent, json))
+					parent._array.push_back(std::move(json));
 			}
+			else {
+				parent._object.emplace(std::move(this->keys.back()), std::move(json));
+				this->keys.pop_back();
 			}
-			return Json{};
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_close(void) {
+			DomType json = std::move(this->stack.back());
+			this->stack.pop_back();
+			this->_value(std::move(json));
 		}
 	}
 
@@ -2156,4 +4366,27 @@ namespace jjyou {
 
 /// @endcond
 
+/** @brief	Hash of Json containers for unordered containers, e.g. to deduplicate values. See `Json::hash`.
+  */
+template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+struct std::hash<jjyou::io::Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>> {
+	using argument_type = jjyou::io::Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+	using result_type = size_t;
+	result_type operator()(argument_type const& key) const {
+		return static_cast<result_type>(key.hash());
+	}
+};
+
+
+/** @brief	Hash of `HashedJson`, i.e. its cached hash.
+  */
+template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+struct std::hash<jjyou::io::HashedJson<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>> {
+	using argument_type = jjyou::io::HashedJson<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+	using result_type = size_t;
+	result_type operator()(argument_type const& key) const {
+		return static_cast<result_type>(key.hash());
+	}
+};
+
 #endif /* jjyou_io_Json_hpp */
\ No newline at end of file
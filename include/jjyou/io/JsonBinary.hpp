@@ -0,0 +1,854 @@
+/***********************************************************************
+ * @file	JsonBinary.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements JsonBinaryWriter and JsonBinaryReader classes.
+***********************************************************************/
+#ifndef jjyou_io_JsonBinary_hpp
+#define jjyou_io_JsonBinary_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <charconv>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @enum	JsonBinaryFormat
+		 * @brief	Binary encodings of Json.
+		 ***********************************************************************/
+		enum class JsonBinaryFormat {
+			CBOR = 0,		/**< Concise Binary Object Representation, RFC 8949. */
+			MsgPack = 1		/**< MessagePack. */
+		};
+
+		/***********************************************************************
+		 * @class	JsonBinaryWriter
+		 * @brief	Event-driven encoder of CBOR and MessagePack.
+		 *
+		 * The member functions have the same names as the handler of `Json::sax`
+		 * and as `JsonSerializer`. `Json::toCBOR` and `Json::toMsgPack` are
+		 * implemented with it, and it can be passed to `Json::sax` to convert a
+		 * text document without building a Json container.
+		 *
+		 * Arrays and objects started with a size are written with a definite length.
+		 * Without a size, as from `Json::sax`, CBOR uses indefinite lengths, while
+		 * MessagePack, which has no such encoding, throws std::runtime_error.
+		 *
+		 * Output is collected in a fixed-size buffer and passed to `sink` as
+		 * `sink(const std::uint8_t* data, std::size_t size)` when the buffer is full,
+		 * on `flush()`, and on destruction.
+		 *
+		 * @tparam	CharTy	The character type. Must be 1 byte, e.g. UTF-8 `char`.
+		 * @tparam	SinkTy	The sink type.
+		 ***********************************************************************/
+		template <class CharTy, class SinkTy>
+		class JsonBinaryWriter {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using CharType = CharTy;
+			using StringViewType = std::basic_string_view<CharType>;
+			static constexpr std::size_t bufferSize = 4096;
+			//@}
+
+			static_assert(sizeof(CharType) == 1, "CBOR and MessagePack strings are UTF-8, so the character type must be 1 byte.");
+
+			/** @brief	Construct a writer.
+			  */
+			JsonBinaryWriter(SinkTy sink, JsonBinaryFormat format) : sink(std::forward<SinkTy>(sink)), format(format) {}
+
+			/** @brief	Copy constructor is disabled.
+			  */
+			JsonBinaryWriter(const JsonBinaryWriter&) = delete;
+
+			/** @brief	Destructor. Flush the buffer, ignoring exceptions thrown by the sink.
+			  */
+			~JsonBinaryWriter(void) {
+				try {
+					this->flush();
+				}
+				catch (...) {}
+			}
+
+			/** @brief	Copy assignment is disabled.
+			  */
+			JsonBinaryWriter& operator=(const JsonBinaryWriter&) = delete;
+
+			/** @name	Events.
+			  */
+			//@{
+			void onNull(void);
+			template <class T>
+			void onInteger(T integer);
+			template <class T>
+			void onFloating(T floating);
+			template <class T>
+			void onBool(T boolean);
+			void onString(StringViewType string);
+			void onRawInteger(StringViewType text);
+			void onRawFloating(StringViewType text);
+			void onStartArray(void);
+			void onStartArray(std::size_t size);
+			void onEndArray(void);
+			void onStartObject(void);
+			void onStartObject(std::size_t size);
+			void onKey(StringViewType key);
+			void onEndObject(void);
+			//@}
+
+			/** @brief	Pass the buffered output to the sink.
+			  */
+			void flush(void);
+
+		private:
+
+			SinkTy sink;
+			JsonBinaryFormat format;
+			std::uint8_t buffer[bufferSize] = {};
+			std::size_t size = 0;
+			std::vector<bool> indefinite{};
+
+			void _put(std::uint8_t byte) {
+				if (this->size == bufferSize)
+					this->flush();
+				this->buffer[this->size++] = byte;
+			}
+			void _write(const std::uint8_t* data, std::size_t length);
+			void _writeBigEndian(std::uint64_t value, std::size_t bytes);
+			void _head(std::uint8_t major, std::uint64_t argument);
+			void _container(bool object, std::size_t size);
+
+		};
+
+		/***********************************************************************
+		 * @class	JsonBinaryReader
+		 * @brief	Decoder of CBOR and MessagePack into `Json::sax` events.
+		 *
+		 * Strings are passed to the handler as views into the input whenever
+		 * they are stored in one piece, i.e. always except for CBOR strings of
+		 * indefinite length. Byte strings (CBOR major type 2, MessagePack bin)
+		 * are passed as strings holding the raw bytes. CBOR tags are ignored,
+		 * and CBOR undefined is decoded as null. Integers that do not fit
+		 * `IntegerTy` are passed as floating points, as in `Json::parse`.
+		 *
+		 * Malformed input and values that have no Json counterpart, such as
+		 * MessagePack extensions or non-string object keys, throw std::runtime_error.
+		 * Nested arrays and objects are decoded with an explicit stack instead of
+		 * recursion, and nesting deeper than `maxDepth` is rejected the same way.
+		 *
+		 * @tparam	IntegerTy, FloatingTy	Same as `Json`.
+		 * @tparam	CharTy	The character type. Must be 1 byte, e.g. UTF-8 `char`.
+		 ***********************************************************************/
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		class JsonBinaryReader {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using IntegerType = IntegerTy;
+			using FloatingType = FloatingTy;
+			using CharType = CharTy;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			static_assert(sizeof(CharType) == 1, "CBOR and MessagePack strings are UTF-8, so the character type must be 1 byte.");
+
+			/** @brief	Construct a reader of `data`, which must stay alive while reading.
+			  * @param	maxDepth	Maximum nesting depth of arrays and objects, as `Json::ParseOptions::maxDepth`.
+			  */
+			JsonBinaryReader(std::span<const std::uint8_t> data, JsonBinaryFormat format, std::size_t maxDepth = 1024) : data(data), format(format), maxDepth(maxDepth) {}
+
+			/** @brief	Decode the next value and pass it to `handler`.
+			  */
+			template <class HandlerTy>
+			void read(HandlerTy& handler);
+
+			/** @brief	Get the number of bytes decoded so far.
+			  */
+			std::size_t position(void) const { return this->pos; }
+
+		private:
+
+			// An open array or object.
+			struct _Container {
+				std::uint64_t size;	// Remaining elements, if not indefinite.
+				bool object;
+				bool indefinite;
+			};
+
+			std::span<const std::uint8_t> data;
+			JsonBinaryFormat format;
+			std::size_t maxDepth;
+			std::size_t pos = 0;
+			std::basic_string<CharType> chunks{};
+			std::vector<_Container> stack{};
+
+			[[noreturn]] void _error(const char* message) const;
+			std::uint8_t _byte(void);
+			std::uint64_t _readBigEndian(std::size_t bytes);
+			StringViewType _view(std::size_t length);
+			template <class HandlerTy>
+			void _unsigned(HandlerTy& handler, std::uint64_t value);
+			template <class HandlerTy>
+			void _signed(HandlerTy& handler, std::int64_t value);
+			void _startContainer(std::size_t start, bool object, bool indefinite, std::uint64_t size);
+			template <class HandlerTy>
+			void _cbor(HandlerTy& handler);
+			std::uint64_t _cborArgument(std::uint8_t initial);
+			StringViewType _cborString(std::uint8_t initial);
+			StringViewType _cborKey(void);
+			static double _halfToDouble(std::uint16_t half);
+			template <class HandlerTy>
+			void _msgPack(HandlerTy& handler);
+			StringViewType _msgPackKey(void);
+
+		};
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::flush(void) {
+			if (this->size != 0) {
+				std::size_t size = this->size;
+				this->size = 0;
+				this->sink(static_cast<const std::uint8_t*>(this->buffer), size);
+			}
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::_write(const std::uint8_t* data, std::size_t length) {
+			if (length > bufferSize - this->size) {
+				this->flush();
+				if (length >= bufferSize) {
+					this->sink(data, length);
+					return;
+				}
+			}
+			std::memcpy(this->buffer + this->size, data, length);
+			this->size += length;
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::_writeBigEndian(std::uint64_t value, std::size_t bytes) {
+			for (std::size_t i = bytes; i-- > 0;)
+				this->_put(static_cast<std::uint8_t>(value >> (8 * i)));
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::_head(std::uint8_t major, std::uint64_t argument) {
+			// CBOR: the major type in the top 3 bits, followed by the shortest encoding of the argument.
+			major = static_cast<std::uint8_t>(major << 5);
+			if (argument < 24) {
+				this->_put(static_cast<std::uint8_t>(major | argument));
+			}
+			else if (argument <= 0xFFULL) {
+				this->_put(major | 24);
+				this->_writeBigEndian(argument, 1);
+			}
+			else if (argument <= 0xFFFFULL) {
+				this->_put(major | 25);
+				this->_writeBigEndian(argument, 2);
+			}
+			else if (argument <= 0xFFFFFFFFULL) {
+				this->_put(major | 26);
+				this->_writeBigEndian(argument, 4);
+			}
+			else {
+				this->_put(major | 27);
+				this->_writeBigEndian(argument, 8);
+			}
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onNull(void) {
+			this->_put(this->format == JsonBinaryFormat::CBOR ? 0xF6 : 0xC0);
+		}
+
+		template <class CharTy, class SinkTy> template <class T>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onInteger(T integer) {
+			using ValueType = std::conditional_t<std::is_integral_v<T>, T, long long>;
+			ValueType value = static_cast<ValueType>(integer);
+			bool negative = false;
+			std::uint64_t magnitude = 0;
+			if constexpr (std::is_signed_v<ValueType>) {
+				negative = (value < 0);
+				// -1 - value does not overflow for negative values.
+				magnitude = negative ? static_cast<std::uint64_t>(-(value + 1)) : static_cast<std::uint64_t>(value);
+			}
+			else {
+				magnitude = static_cast<std::uint64_t>(value);
+			}
+			if (this->format == JsonBinaryFormat::CBOR) {
+				this->_head(negative ? 1 : 0, magnitude);
+				return;
+			}
+			if (!negative) {
+				if (magnitude <= 0x7FULL) {
+					this->_put(static_cast<std::uint8_t>(magnitude));
+				}
+				else if (magnitude <= 0xFFULL) {
+					this->_put(0xCC);
+					this->_writeBigEndian(magnitude, 1);
+				}
+				else if (magnitude <= 0xFFFFULL) {
+					this->_put(0xCD);
+					this->_writeBigEndian(magnitude, 2);
+				}
+				else if (magnitude <= 0xFFFFFFFFULL) {
+					this->_put(0xCE);
+					this->_writeBigEndian(magnitude, 4);
+				}
+				else {
+					this->_put(0xCF);
+					this->_writeBigEndian(magnitude, 8);
+				}
+				return;
+			}
+			std::int64_t signedValue = static_cast<std::int64_t>(value);
+			std::uint64_t bits = static_cast<std::uint64_t>(signedValue);
+			if (signedValue >= -32) {
+				this->_put(static_cast<std::uint8_t>(bits));
+			}
+			else if (signedValue >= std::numeric_limits<std::int8_t>::min()) {
+				this->_put(0xD0);
+				this->_writeBigEndian(bits, 1);
+			}
+			else if (signedValue >= std::numeric_limits<std::int16_t>::min()) {
+				this->_put(0xD1);
+				this->_writeBigEndian(bits, 2);
+			}
+			else if (signedValue >= std::numeric_limits<std::int32_t>::min()) {
+				this->_put(0xD2);
+				this->_writeBigEndian(bits, 4);
+			}
+			else {
+				this->_put(0xD3);
+				this->_writeBigEndian(bits, 8);
+			}
+		}
+
+		template <class CharTy, class SinkTy> template <class T>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onFloating(T floating) {
+			const bool cbor = (this->format == JsonBinaryFormat::CBOR);
+			if constexpr (std::is_same_v<T, float>) {
+				this->_put(cbor ? 0xFA : 0xCA);
+				this->_writeBigEndian(std::bit_cast<std::uint32_t>(floating), 4);
+			}
+			else {
+				this->_put(cbor ? 0xFB : 0xCB);
+				this->_writeBigEndian(std::bit_cast<std::uint64_t>(static_cast<double>(floating)), 8);
+			}
+		}
+
+		template <class CharTy, class SinkTy> template <class T>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onBool(T boolean) {
+			if (this->format == JsonBinaryFormat::CBOR)
+				this->_put(static_cast<bool>(boolean) ? 0xF5 : 0xF4);
+			else
+				this->_put(static_cast<bool>(boolean) ? 0xC3 : 0xC2);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onString(StringViewType string) {
+			const std::size_t length = string.size();
+			if (this->format == JsonBinaryFormat::CBOR) {
+				this->_head(3, length);
+			}
+			else if (length < 32) {
+				this->_put(static_cast<std::uint8_t>(0xA0 | length));
+			}
+			else if (length <= 0xFF) {
+				this->_put(0xD9);
+				this->_writeBigEndian(length, 1);
+			}
+			else if (length <= 0xFFFF) {
+				this->_put(0xDA);
+				this->_writeBigEndian(length, 2);
+			}
+			else {
+				this->_put(0xDB);
+				this->_writeBigEndian(length, 4);
+			}
+			this->_write(reinterpret_cast<const std::uint8_t*>(string.data()), length);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onRawInteger(StringViewType text) {
+			const char* first = reinterpret_cast<const char*>(text.data());
+			long long integer = 0LL;
+			if (std::from_chars(first, first + text.size(), integer).ec == std::errc())
+				this->onInteger(integer);
+			else
+				this->onRawFloating(text);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onRawFloating(StringViewType text) {
+			const char* first = reinterpret_cast<const char*>(text.data());
+			double floating = 0.0;
+			if (std::from_chars(first, first + text.size(), floating).ec == std::errc::result_out_of_range)
+				floating = std::strtod(std::string(first, text.size()).c_str(), nullptr);
+			this->onFloating(floating);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::_container(bool object, std::size_t size) {
+			this->indefinite.push_back(false);
+			if (this->format == JsonBinaryFormat::CBOR) {
+				this->_head(object ? 5 : 4, size);
+			}
+			else if (size < 16) {
+				this->_put(static_cast<std::uint8_t>((object ? 0x80 : 0x90) | size));
+			}
+			else if (size <= 0xFFFF) {
+				this->_put(object ? 0xDE : 0xDC);
+				this->_writeBigEndian(size, 2);
+			}
+			else {
+				this->_put(object ? 0xDF : 0xDD);
+				this->_writeBigEndian(size, 4);
+			}
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onStartArray(void) {
+			if (this->format != JsonBinaryFormat::CBOR)
+				throw std::runtime_error("[Json MsgPack] Arrays and objects must be started with their size.");
+			this->indefinite.push_back(true);
+			this->_put(0x9F);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onStartArray(std::size_t size) {
+			this->_container(false, size);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onEndArray(void) {
+			if (this->indefinite.back())
+				this->_put(0xFF);
+			this->indefinite.pop_back();
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onStartObject(void) {
+			if (this->format != JsonBinaryFormat::CBOR)
+				throw std::runtime_error("[Json MsgPack] Arrays and objects must be started with their size.");
+			this->indefinite.push_back(true);
+			this->_put(0xBF);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onStartObject(std::size_t size) {
+			this->_container(true, size);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onKey(StringViewType key) {
+			this->onString(key);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonBinaryWriter<CharTy, SinkTy>::onEndObject(void) {
+			this->onEndArray();
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline void JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_error(const char* message) const {
+			throw std::runtime_error(
+				std::string(this->format == JsonBinaryFormat::CBOR ? "[Json CBOR] pos:" : "[Json MsgPack] pos:") +
+				std::to_string(this->pos + 1) + " " + message
+			);
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline std::uint8_t JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_byte(void) {
+			if (this->pos == this->data.size())
+				this->_error("Unexpected end of data.");
+			return this->data[this->pos++];
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline std::uint64_t JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_readBigEndian(std::size_t bytes) {
+			if (this->data.size() - this->pos < bytes)
+				this->_error("Unexpected end of data.");
+			std::uint64_t value = 0;
+			for (std::size_t i = 0; i < bytes; ++i)
+				value = (value << 8) | this->data[this->pos++];
+			return value;
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline typename JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::StringViewType JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_view(std::size_t length) {
+			if (this->data.size() - this->pos < length)
+				this->_error("Unexpected end of data.");
+			StringViewType res(reinterpret_cast<const CharType*>(this->data.data() + this->pos), length);
+			this->pos += length;
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy> template <class HandlerTy>
+		inline void JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_unsigned(HandlerTy& handler, std::uint64_t value) {
+			if constexpr (std::is_integral_v<IntegerType>) {
+				if (value <= static_cast<std::uint64_t>(std::numeric_limits<IntegerType>::max())) {
+					handler.onInteger(static_cast<IntegerType>(value));
+					return;
+				}
+			}
+			else {
+				if (value <= static_cast<std::uint64_t>(std::numeric_limits<long long>::max())) {
+					handler.onInteger(static_cast<IntegerType>(static_cast<long long>(value)));
+					return;
+				}
+			}
+			handler.onFloating(static_cast<FloatingType>(value));
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy> template <class HandlerTy>
+		inline void JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_signed(HandlerTy& handler, std::int64_t value) {
+			if (value >= 0) {
+				this->_unsigned(handler, static_cast<std::uint64_t>(value));
+				return;
+			}
+			if constexpr (std::is_integral_v<IntegerType>) {
+				if (std::is_signed_v<IntegerType> && value >= static_cast<std::int64_t>(std::numeric_limits<IntegerType>::min())) {
+					handler.onInteger(static_cast<IntegerType>(value));
+					return;
+				}
+			}
+			else {
+				handler.onInteger(static_cast<IntegerType>(static_cast<long long>(value)));
+				return;
+			}
+			handler.onFloating(static_cast<FloatingType>(value));
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy> template <class HandlerTy>
+		inline void JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::read(HandlerTy& handler) {
+			// `_cbor` and `_msgPack` decode one item. An array or object is only started, and its
+			// elements are decoded by the following iterations, so the call stack does not grow
+			// with the nesting depth.
+			const bool cbor = (this->format == JsonBinaryFormat::CBOR);
+			this->stack.clear();
+			do {
+				if (!this->stack.empty()) {
+					_Container& container = this->stack.back();
+					bool end = false;
+					if (container.indefinite) {
+						if (this->pos == this->data.size())
+							this->_error("Unexpected end of data.");
+						end = (this->data[this->pos] == 0xFF);
+						if (end)
+							++this->pos;
+					}
+					else {
+						end = (container.size == 0);
+						if (!end)
+							--container.size;
+					}
+					if (end) {
+						if (container.object)
+							handler.onEndObject();
+						else
+							handler.onEndArray();
+						this->stack.pop_back();
+						continue;
+					}
+					if (container.object)
+						handler.onKey(cbor ? this->_cborKey() : this->_msgPackKey());
+				}
+				if (cbor)
+					this->_cbor(handler);
+				else
+					this->_msgPack(handler);
+			} while (!this->stack.empty());
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline void JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_startContainer(std::size_t start, bool object, bool indefinite, std::uint64_t size) {
+			if (this->stack.size() >= this->maxDepth) {
+				this->pos = start;
+				this->_error("Maximum nesting depth exceeded.");
+			}
+			this->stack.push_back(_Container{ size, object, indefinite });
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline std::uint64_t JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_cborArgument(std::uint8_t initial) {
+			std::uint8_t info = initial & 0x1F;
+			if (info < 24)
+				return info;
+			if (info > 27)
+				this->_error("Invalid additional information.");
+			return this->_readBigEndian(std::size_t(1) << (info - 24));
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline typename JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::StringViewType JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_cborString(std::uint8_t initial) {
+			const std::uint8_t major = initial >> 5;
+			if ((initial & 0x1F) != 31) {
+				std::uint64_t length = this->_cborArgument(initial);
+				if (length > this->data.size() - this->pos)
+					this->_error("Unexpected end of data.");
+				return this->_view(static_cast<std::size_t>(length));
+			}
+			// Indefinite length: definite-length chunks of the same major type, ended by a break.
+			this->chunks.clear();
+			for (std::uint8_t chunk = this->_byte(); chunk != 0xFF; chunk = this->_byte()) {
+				if ((chunk >> 5) != major || (chunk & 0x1F) == 31)
+					this->_error("Invalid chunk of an indefinite-length string.");
+				std::uint64_t length = this->_cborArgument(chunk);
+				if (length > this->data.size() - this->pos)
+					this->_error("Unexpected end of data.");
+				this->chunks.append(this->_view(static_cast<std::size_t>(length)));
+			}
+			return StringViewType(this->chunks);
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline typename JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::StringViewType JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_cborKey(void) {
+			std::uint8_t key = this->_byte();
+			while ((key >> 5) == 6) { // Tagged key
+				this->_cborArgument(key);
+				key = this->_byte();
+			}
+			if ((key >> 5) != 2 && (key >> 5) != 3) {
+				--this->pos;
+				this->_error("Object's key must be a string.");
+			}
+			return this->_cborString(key);
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline double JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_halfToDouble(std::uint16_t half) {
+			// RFC 8949, Appendix D.
+			const int exponent = (half >> 10) & 0x1F;
+			const int mantissa = half & 0x3FF;
+			double value = 0.0;
+			if (exponent == 0)
+				value = std::ldexp(mantissa, -24);
+			else if (exponent != 31)
+				value = std::ldexp(mantissa + 1024, exponent - 25);
+			else
+				value = (mantissa == 0) ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+			return (half & 0x8000) ? -value : value;
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy> template <class HandlerTy>
+		void JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_cbor(HandlerTy& handler) {
+			std::uint8_t initial = this->_byte();
+			while ((initial >> 5) == 6) { // Tag, ignored
+				this->_cborArgument(initial);
+				initial = this->_byte();
+			}
+			const std::uint8_t major = initial >> 5;
+			const bool indefinite = ((initial & 0x1F) == 31);
+			switch (major) {
+			case 0: /* Unsigned integer */
+			{
+				this->_unsigned(handler, this->_cborArgument(initial));
+				return;
+			}
+			case 1: /* Negative integer, -1 - argument */
+			{
+				std::uint64_t argument = this->_cborArgument(initial);
+				if (argument <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+					this->_signed(handler, -1 - static_cast<std::int64_t>(argument));
+				else
+					handler.onFloating(static_cast<FloatingType>(-1.0 - static_cast<double>(argument)));
+				return;
+			}
+			case 2: /* Byte string */
+			case 3: /* Text string */
+			{
+				handler.onString(this->_cborString(initial));
+				return;
+			}
+			case 4: /* Array */
+			case 5: /* Map */
+			{
+				const std::size_t start = this->pos - 1;
+				this->_startContainer(start, major == 5, indefinite, indefinite ? 0 : this->_cborArgument(initial));
+				if (major == 5)
+					handler.onStartObject();
+				else
+					handler.onStartArray();
+				return;
+			}
+			case 7: /* Simple values and floating points */
+			default:
+			{
+				switch (initial & 0x1F) {
+				case 20:
+					handler.onBool(false);
+					return;
+				case 21:
+					handler.onBool(true);
+					return;
+				case 22: /* null */
+				case 23: /* undefined */
+					handler.onNull();
+					return;
+				case 25:
+					handler.onFloating(static_cast<FloatingType>(JsonBinaryReader::_halfToDouble(static_cast<std::uint16_t>(this->_readBigEndian(2)))));
+					return;
+				case 26:
+					handler.onFloating(static_cast<FloatingType>(std::bit_cast<float>(static_cast<std::uint32_t>(this->_readBigEndian(4)))));
+					return;
+				case 27:
+					handler.onFloating(static_cast<FloatingType>(std::bit_cast<double>(this->_readBigEndian(8))));
+					return;
+				case 31:
+					--this->pos;
+					this->_error("Unexpected break.");
+				default:
+					--this->pos;
+					this->_error("Unsupported simple value.");
+				}
+			}
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy>
+		inline typename JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::StringViewType JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_msgPackKey(void) {
+			const std::uint8_t initial = this->_byte();
+			if (initial >= 0xA0 && initial <= 0xBF)
+				return this->_view(initial & 0x1F);
+			switch (initial) {
+			case 0xC4: case 0xD9:
+				return this->_view(static_cast<std::size_t>(this->_readBigEndian(1)));
+			case 0xC5: case 0xDA:
+				return this->_view(static_cast<std::size_t>(this->_readBigEndian(2)));
+			case 0xC6: case 0xDB:
+				return this->_view(static_cast<std::size_t>(this->_readBigEndian(4)));
+			default:
+				--this->pos;
+				this->_error("Object's key must be a string.");
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class CharTy> template <class HandlerTy>
+		void JsonBinaryReader<IntegerTy, FloatingTy, CharTy>::_msgPack(HandlerTy& handler) {
+			const std::size_t start = this->pos;
+			const std::uint8_t initial = this->_byte();
+			if (initial <= 0x7F) { /* Positive fixint */
+				this->_unsigned(handler, initial);
+				return;
+			}
+			if (initial >= 0xE0) { /* Negative fixint */
+				this->_signed(handler, static_cast<std::int8_t>(initial));
+				return;
+			}
+			if (initial >= 0xA0 && initial <= 0xBF) { /* Fixstr */
+				--this->pos;
+				handler.onString(this->_msgPackKey());
+				return;
+			}
+			std::size_t arraySize = 0;
+			std::size_t mapSize = 0;
+			if (initial >= 0x80 && initial <= 0x8F) {
+				mapSize = initial & 0x0F;
+			}
+			else if (initial >= 0x90 && initial <= 0x9F) {
+				arraySize = initial & 0x0F;
+			}
+			else {
+				switch (initial) {
+				case 0xC0:
+					handler.onNull();
+					return;
+				case 0xC2:
+					handler.onBool(false);
+					return;
+				case 0xC3:
+					handler.onBool(true);
+					return;
+				case 0xC4: case 0xC5: case 0xC6: /* bin */
+				case 0xD9: case 0xDA: case 0xDB: /* str */
+					--this->pos;
+					handler.onString(this->_msgPackKey());
+					return;
+				case 0xCA:
+					handler.onFloating(static_cast<FloatingType>(std::bit_cast<float>(static_cast<std::uint32_t>(this->_readBigEndian(4)))));
+					return;
+				case 0xCB:
+					handler.onFloating(static_cast<FloatingType>(std::bit_cast<double>(this->_readBigEndian(8))));
+					return;
+				case 0xCC: case 0xCD: case 0xCE: case 0xCF: /* uint 8/16/32/64 */
+					this->_unsigned(handler, this->_readBigEndian(std::size_t(1) << (initial - 0xCC)));
+					return;
+				case 0xD0: case 0xD1: case 0xD2: case 0xD3: /* int 8/16/32/64 */
+				{
+					const std::size_t bytes = std::size_t(1) << (initial - 0xD0);
+					std::uint64_t bits = this->_readBigEndian(bytes);
+					// Sign-extend.
+					if (bytes < 8 && (bits >> (8 * bytes - 1)) != 0)
+						bits |= ~std::uint64_t(0) << (8 * bytes);
+					this->_signed(handler, static_cast<std::int64_t>(bits));
+					return;
+				}
+				case 0xDC:
+					arraySize = static_cast<std::size_t>(this->_readBigEndian(2));
+					break;
+				case 0xDD:
+					arraySize = static_cast<std::size_t>(this->_readBigEndian(4));
+					break;
+				case 0xDE:
+					mapSize = static_cast<std::size_t>(this->_readBigEndian(2));
+					break;
+				case 0xDF:
+					mapSize = static_cast<std::size_t>(this->_readBigEndian(4));
+					break;
+				default:
+					--this->pos;
+					this->_error("Unsupported type (extension or reserved).");
+				}
+			}
+			const bool object = (initial == 0xDE || initial == 0xDF || (initial >= 0x80 && initial <= 0x8F));
+			this->_startContainer(start, object, false, object ? mapSize : arraySize);
+			if (object)
+				handler.onStartObject();
+			else
+				handler.onStartArray();
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonBinary_hpp */
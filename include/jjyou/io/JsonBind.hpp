@@ -0,0 +1,619 @@
+/***********************************************************************
+ * @file	JsonBind.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements JsonBinder class and the JJYOU_JSON_DESCRIBE macro.
+***********************************************************************/
+#ifndef jjyou_io_JsonBind_hpp
+#define jjyou_io_JsonBind_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <stdexcept>
+#include <sstream>
+#include "Json.hpp"
+
+namespace jjyou {
+
+	namespace glsl {
+		template <class T, int Length> class vec;
+		template <class T, int Cols, int Rows> class mat;
+	}
+
+	namespace io {
+
+		/***********************************************************************
+		 * @struct	JsonField
+		 * @brief	A member of a struct bound to the member of a Json object with the key `name`.
+		 ***********************************************************************/
+		template <class ClassTy, class MemberTy>
+		struct JsonField {
+			const char* name;
+			MemberTy ClassTy::* member;
+			constexpr JsonField(const char* name, MemberTy ClassTy::* member) : name(name), member(member) {}
+		};
+
+		/** @brief	Whether the members of `T` are described, see `JJYOU_JSON_DESCRIBE`.
+		  */
+		template <class T>
+		concept JsonDescribed = requires { jjyouJsonDescribe(static_cast<const T*>(nullptr)); };
+
+		/***********************************************************************
+		 * @class	JsonBinder
+		 * @brief	Read json directly into C++ objects and write them back, without a Json container.
+		 *
+		 * Values are read from the tokens of the lexer of `JsonTy`, and written as
+		 * the events of `JsonSerializer`. The following types are bound:
+		 *  - `bool`, integers, floating points and enums (as their underlying integers).
+		 *    Integers must be in range, floating points also accept integers.
+		 *  - `std::basic_string` of the character type of `JsonTy`.
+		 *  - `std::optional`, which is null if it is empty.
+		 *  - Structs described by `JJYOU_JSON_DESCRIBE`, as objects. Unknown keys are
+		 *    skipped, and members without a key keep their values.
+		 *  - `std::array`, `jjyou::glsl::vec` and fixed-size Eigen vectors, as arrays of
+		 *    exactly their length. `jjyou::glsl::mat` is an array of columns, other Eigen
+		 *    matrices are arrays of rows.
+		 *  - Containers with `emplace_back`, such as `std::vector`, as arrays, and
+		 *    containers with `try_emplace` and string keys, such as `std::map`, as objects.
+		 *  - `JsonTy` itself, for parts of a document whose layout is not fixed.
+		 *
+		 * Containers are cleared before they are read. If an object has duplicate keys,
+		 * the last one wins. Errors have the format of `Json::parse` and are thrown as
+		 * std::runtime_error.
+		 *
+		 * @tparam	JsonTy	The Json type whose lexer and string types are used. Default is
+		 *			`Json<long long, double>`, so that numbers are read at full precision.
+		 ***********************************************************************/
+		template <class JsonTy = Json<long long, double>>
+		class JsonBinder {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using DomType = JsonTy;
+			using CharType = typename DomType::CharType;
+			using StringType = typename JsonOwningString<typename DomType::StringType>::type;
+			using StringViewType = std::basic_string_view<CharType>;
+			using ParseOptions = typename DomType::ParseOptions;
+			//@}
+
+			/** @brief	Parse json into `value`.
+			  *
+			  * `src` is the same as in `Json::parse`. Of `options`, only `maxDepth` is used. It
+			  * bounds the nesting of the input, including the parts read into `JsonTy` members
+			  * or skipped, so recursive types such as `struct Node { std::vector<Node> children; }`
+			  * cannot overflow the call stack.
+			  */
+			template <class T, class SrcTy>
+			static void parse(SrcTy&& src, T& value, const ParseOptions& options = ParseOptions());
+
+			/** @brief	Parse json into a default-constructed `T`.
+			  */
+			template <class T, class SrcTy>
+			static T parse(SrcTy&& src, const ParseOptions& options = ParseOptions()) {
+				T res{};
+				JsonBinder::parse(std::forward<SrcTy>(src), res, options);
+				return res;
+			}
+
+			/** @brief	Pass `value` to a handler as the events of `Json::sax`.
+			  *
+			  * `handler` can be e.g. a `JsonSerializer`, a `JsonBinaryWriter` or a `JsonDomBuilder`.
+			  * Integers are passed unchanged to handlers whose `onInteger` is a template, as in
+			  * `JsonSerializer`. Other handlers get an `IntegerType`, and an exception of type
+			  * std::out_of_range is thrown if the integer does not fit.
+			  */
+			template <class T, class HandlerTy>
+			static void emit(const T& value, HandlerTy& handler);
+
+			/** @brief	Serialize `value` into a sink, called as `sink(const CharType* data, std::size_t size)`.
+			  */
+			template <class T, class SinkTy> requires std::is_invocable_v<SinkTy&, const CharType*, std::size_t>
+			static void dump(const T& value, SinkTy&& sink, const JsonDumpOptions& options = JsonDumpOptions()) {
+				JsonSerializer<CharType, SinkTy&> serializer(sink, options);
+				JsonBinder::emit(value, serializer);
+				serializer.flush();
+			}
+
+			/** @brief	Serialize `value` to a string.
+			  */
+			template <class T>
+			static StringType dump(const T& value, const JsonDumpOptions& options = JsonDumpOptions()) {
+				StringType res{};
+				JsonBinder::dump(value, [&res](const CharType* data, std::size_t size) -> void {
+					res.append(data, size);
+				}, options);
+				return res;
+			}
+
+		private:
+
+			using InputAdapter = typename DomType::InputAdapter;
+			using Token = typename DomType::Token;
+			using Lexer = typename DomType::Lexer;
+
+			template <class T> struct _IsOptional : std::false_type {};
+			template <class T> struct _IsOptional<std::optional<T>> : std::true_type {};
+			template <class T> struct _Fixed { static constexpr bool value = false; };
+			template <class T, std::size_t N> struct _Fixed<std::array<T, N>> { static constexpr bool value = true; static constexpr std::size_t size = N; };
+			template <class T, int N> struct _Fixed<glsl::vec<T, N>> { static constexpr bool value = true; static constexpr std::size_t size = N; };
+			template <class T, int Cols, int Rows> struct _Fixed<glsl::mat<T, Cols, Rows>> { static constexpr bool value = true; static constexpr std::size_t size = Cols; };
+
+			// Eigen's dense matrices, detected without including Eigen.
+			template <class T>
+			static constexpr bool _isEigen = requires { T::RowsAtCompileTime; T::ColsAtCompileTime; typename T::Scalar; };
+
+			template <class T>
+			static constexpr bool _isString = requires { typename T::traits_type; requires std::is_same_v<typename T::value_type, CharType>; };
+
+			// Consumes any value, for the keys that are not bound.
+			struct _Skipper {
+				template <class... Args> void onNull(Args&&...) {}
+				template <class... Args> void onInteger(Args&&...) {}
+				template <class... Args> void onFloating(Args&&...) {}
+				template <class... Args> void onBool(Args&&...) {}
+				template <class... Args> void onString(Args&&...) {}
+				template <class... Args> void onStartArray(Args&&...) {}
+				template <class... Args> void onEndArray(Args&&...) {}
+				template <class... Args> void onStartObject(Args&&...) {}
+				template <class... Args> void onKey(Args&&...) {}
+				template <class... Args> void onEndObject(Args&&...) {}
+			};
+
+			[[noreturn]] static void _error(const Lexer& lexer, Token token, const char* message);
+			static Token _expect(Lexer& lexer, JsonTokenType type, const char* message);
+			// Consume the comma before an array element or object member, if it is not the first one.
+			// Return false at the closing bracket.
+			static bool _next(Lexer& lexer, JsonTokenType close, bool& first);
+			static bool _equals(const char* name, StringViewType key);
+			// Open an array or object. The remaining depth is kept in `lexer.maxDepth`, so that
+			// values parsed by `Json::_sax` inside it get the rest of the limit.
+			static void _enter(Lexer& lexer, const Token& open);
+			static void _leave(Lexer& lexer) { ++lexer.maxDepth; }
+			template <class T>
+			static void _read(Lexer& lexer, T& value);
+			template <class T>
+			static void _readObject(Lexer& lexer, T& value);
+			template <class T>
+			static void _readEigen(Lexer& lexer, T& value);
+			template <class HandlerTy>
+			static void _key(const char* name, HandlerTy& handler);
+			template <class HandlerTy>
+			static void _startArray(std::size_t size, HandlerTy& handler);
+
+		};
+
+		/** @brief	Parse json directly into a `T`. See `JsonBinder`.
+		  */
+		template <class T, class JsonTy = Json<long long, double>, class SrcTy>
+		T parseInto(SrcTy&& src, const typename JsonBinder<JsonTy>::ParseOptions& options = typename JsonBinder<JsonTy>::ParseOptions()) {
+			return JsonBinder<JsonTy>::template parse<T>(std::forward<SrcTy>(src), options);
+		}
+
+		/** @brief	Serialize a `T` directly to a string. See `JsonBinder`.
+		  */
+		template <class JsonTy = Json<long long, double>, class T>
+		typename JsonBinder<JsonTy>::StringType dumpFrom(const T& value, const JsonDumpOptions& options = JsonDumpOptions()) {
+			return JsonBinder<JsonTy>::dump(value, options);
+		}
+
+	}
+
+}
+
+/** @brief	Describe the members of a struct for `JsonBinder`.
+  *
+  * Use it at namespace scope, in the namespace of the struct:
+  * `JJYOU_JSON_DESCRIBE(Camera, name, position, fov)` binds the members `name`,
+  * `position` and `fov` to the keys "name", "position" and "fov". It defines
+  * `jjyouJsonDescribe(const Camera*)`, which is found by argument-dependent
+  * lookup. To use other keys, define this function directly, returning a tuple
+  * of `jjyou::io::JsonField`, e.g.
+  * `std::make_tuple(jjyou::io::JsonField("fov_deg", &Camera::fov))`.
+  */
+#define JJYOU_JSON_DESCRIBE(Type, ...) \
+	[[maybe_unused]] constexpr inline auto jjyouJsonDescribe(const Type*) { \
+		return std::make_tuple(JJYOU_JSON_FOR_EACH_FIELD(Type, __VA_ARGS__)); \
+	}
+
+/// @cond
+#define JJYOU_JSON_PARENS ()
+#define JJYOU_JSON_EXPAND(...) JJYOU_JSON_EXPAND3(JJYOU_JSON_EXPAND3(JJYOU_JSON_EXPAND3(JJYOU_JSON_EXPAND3(__VA_ARGS__))))
+#define JJYOU_JSON_EXPAND3(...) JJYOU_JSON_EXPAND2(JJYOU_JSON_EXPAND2(JJYOU_JSON_EXPAND2(JJYOU_JSON_EXPAND2(__VA_ARGS__))))
+#define JJYOU_JSON_EXPAND2(...) JJYOU_JSON_EXPAND1(JJYOU_JSON_EXPAND1(JJYOU_JSON_EXPAND1(JJYOU_JSON_EXPAND1(__VA_ARGS__))))
+#define JJYOU_JSON_EXPAND1(...) __VA_ARGS__
+#define JJYOU_JSON_FOR_EACH_FIELD(Type, ...) __VA_OPT__(JJYOU_JSON_EXPAND(JJYOU_JSON_FIELD(Type, __VA_ARGS__)))
+#define JJYOU_JSON_FIELD(Type, member, ...) ::jjyou::io::JsonField(#member, &Type::member) __VA_OPT__(, JJYOU_JSON_FIELD_AGAIN JJYOU_JSON_PARENS (Type, __VA_ARGS__))
+#define JJYOU_JSON_FIELD_AGAIN() JJYOU_JSON_FIELD
+/// @endcond
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class JsonTy> template <class T, class SrcTy>
+		inline void JsonBinder<JsonTy>::parse(SrcTy&& src, T& value, const ParseOptions& options) {
+			InputAdapter inputAdapter(std::forward<SrcTy>(src));
+			Lexer lexer(inputAdapter, typename DomType::AllocatorType());
+			lexer.maxDepth = options.maxDepth;
+			JsonBinder::_read(lexer, value);
+		}
+
+		template <class JsonTy>
+		inline void JsonBinder<JsonTy>::_error(const Lexer& lexer, Token token, const char* message) {
+			lexer._locate(token);
+			std::basic_stringstream<CharType> sstream;
+			sstream << "[Json Parser] ln:" << (token.line + 1U) << ", col:" << (token.col + 1U) << ", pos:" << (token.pos + 1U) << " ";
+			if (token.type == JsonTokenType::End)
+				sstream << "Unexpected EOF.";
+			else if (token.type == JsonTokenType::Unexpected)
+				sstream << "Unexpected characters \"" << std::get<2>(token.data) << "\".";
+			else
+				sstream << message;
+			throw std::runtime_error(InputAdapter::_toStdString(sstream.str()));
+		}
+
+		template <class JsonTy>
+		inline typename JsonBinder<JsonTy>::Token JsonBinder<JsonTy>::_expect(Lexer& lexer, JsonTokenType type, const char* message) {
+			Token token = lexer.get();
+			if (token.type != type)
+				JsonBinder::_error(lexer, token, message);
+			return token;
+		}
+
+		template <class JsonTy>
+		inline bool JsonBinder<JsonTy>::_next(Lexer& lexer, JsonTokenType close, bool& first) {
+			Token token = lexer.peek();
+			if (token.type == close) {
+				lexer.get();
+				return false;
+			}
+			if (!first) {
+				token = lexer.get();
+				if (token.type != JsonTokenType::Comma)
+					JsonBinder::_error(lexer, token, close == JsonTokenType::Rbracket ? "Missing comma to separate elements in an array." : "Missing comma to separate elements in an object.");
+			}
+			first = false;
+			return true;
+		}
+
+		template <class JsonTy>
+		inline void JsonBinder<JsonTy>::_enter(Lexer& lexer, const Token& open) {
+			if (lexer.maxDepth == 0)
+				JsonBinder::_error(lexer, open, "Maximum nesting depth exceeded.");
+			--lexer.maxDepth;
+		}
+
+		template <class JsonTy>
+		inline bool JsonBinder<JsonTy>::_equals(const char* name, StringViewType key) {
+			if constexpr (std::is_same_v<CharType, char>)
+				return key == std::string_view(name);
+			else {
+				std::size_t i = 0;
+				for (; i < key.size(); ++i)
+					if (name[i] == '\0' || static_cast<CharType>(name[i]) != key[i])
+						return false;
+				return name[i] == '\0';
+			}
+		}
+
+		template <class JsonTy> template <class T>
+		void JsonBinder<JsonTy>::_read(Lexer& lexer, T& value) {
+			if constexpr (std::is_same_v<T, DomType>) {
+				static_assert(!JsonIsStringView<typename DomType::StringType>, "A Json whose StringTy is a string view cannot be bound.");
+				typename DomType::DomBuilder builder;
+				DomType::_sax(lexer, builder);
+				value = builder.release();
+			}
+			else if constexpr (std::is_same_v<T, bool>) {
+				Token token = JsonBinder::_expect(lexer, JsonTokenType::Bool, "Expected a bool.");
+				value = static_cast<bool>(std::get<3>(token.data));
+			}
+			else if constexpr (std::is_enum_v<T>) {
+				std::underlying_type_t<T> underlying{};
+				JsonBinder::_read(lexer, underlying);
+				value = static_cast<T>(underlying);
+			}
+			else if constexpr (std::is_integral_v<T>) {
+				Token token = lexer.get();
+				// The lexer keeps integers out of the range of `IntegerType` as floating points.
+				if (token.type == JsonTokenType::Floating && token.overflow)
+					JsonBinder::_error(lexer, token, "Integer out of range.");
+				if (token.type != JsonTokenType::Integer)
+					JsonBinder::_error(lexer, token, "Expected an integer.");
+				auto integer = std::get<0>(token.data);
+				if constexpr (std::is_integral_v<decltype(integer)>) {
+					// `std::in_range` does not accept character types.
+					using RangeType = std::conditional_t<std::is_signed_v<T>, std::make_signed_t<T>, std::make_unsigned_t<T>>;
+					if (!std::in_range<RangeType>(integer))
+						JsonBinder::_error(lexer, token, "Integer out of range.");
+				}
+				value = static_cast<T>(integer);
+			}
+			else if constexpr (std::is_floating_point_v<T>) {
+				Token token = lexer.get();
+				if (token.type == JsonTokenType::Floating)
+					value = static_cast<T>(std::get<1>(token.data));
+				else if (token.type == JsonTokenType::Integer)
+					value = static_cast<T>(std::get<0>(token.data));
+				else
+					JsonBinder::_error(lexer, token, "Expected a number.");
+			}
+			else if constexpr (_isString<T>) {
+				Token token = JsonBinder::_expect(lexer, JsonTokenType::String, "Expected a string.");
+				StringViewType view = token.view();
+				value.assign(view.data(), view.size());
+			}
+			else if constexpr (_IsOptional<T>::value) {
+				if (lexer.peek().type == JsonTokenType::Null) {
+					lexer.get();
+					value.reset();
+				}
+				else
+					JsonBinder::_read(lexer, value.emplace());
+			}
+			else if constexpr (JsonDescribed<T>) {
+				JsonBinder::_readObject(lexer, value);
+			}
+			else if constexpr (_Fixed<T>::value) {
+				Token open = JsonBinder::_expect(lexer, JsonTokenType::Lbracket, "Expected an array.");
+				JsonBinder::_enter(lexer, open);
+				bool first = true;
+				for (std::size_t i = 0; i < _Fixed<T>::size; ++i) {
+					if (!JsonBinder::_next(lexer, JsonTokenType::Rbracket, first))
+						JsonBinder::_error(lexer, open, "Too few elements in a fixed-size array.");
+					JsonBinder::_read(lexer, value[i]);
+				}
+				if (JsonBinder::_next(lexer, JsonTokenType::Rbracket, first))
+					JsonBinder::_error(lexer, open, "Too many elements in a fixed-size array.");
+				JsonBinder::_leave(lexer);
+			}
+			else if constexpr (_isEigen<T>) {
+				JsonBinder::_readEigen(lexer, value);
+			}
+			else if constexpr (requires { typename T::key_type; typename T::mapped_type; value.try_emplace(std::declval<typename T::key_type>()); }) {
+				static_assert(_isString<typename T::key_type>, "The key type of a map bound to a Json object must be a string.");
+				JsonBinder::_enter(lexer, JsonBinder::_expect(lexer, JsonTokenType::Lbrace, "Expected an object."));
+				value.clear();
+				bool first = true;
+				while (JsonBinder::_next(lexer, JsonTokenType::Rbrace, first)) {
+					Token key = JsonBinder::_expect(lexer, JsonTokenType::String, "Object's key must be a string.");
+					StringViewType view = key.view();
+					typename T::mapped_type& mapped = value.try_emplace(typename T::key_type(view.data(), view.size())).first->second;
+					JsonBinder::_expect(lexer, JsonTokenType::Colon, "Missing colon to separate key and value.");
+					JsonBinder::_read(lexer, mapped);
+				}
+				JsonBinder::_leave(lexer);
+			}
+			else if constexpr (requires { typename T::value_type; value.emplace_back(); value.clear(); }) {
+				JsonBinder::_enter(lexer, JsonBinder::_expect(lexer, JsonTokenType::Lbracket, "Expected an array."));
+				value.clear();
+				bool first = true;
+				while (JsonBinder::_next(lexer, JsonTokenType::Rbracket, first)) {
+					// `std::vector<bool>` has no references to its elements.
+					if constexpr (std::is_same_v<typename T::value_type, bool>) {
+						bool element = false;
+						JsonBinder::_read(lexer, element);
+						value.push_back(element);
+					}
+					else
+						JsonBinder::_read(lexer, value.emplace_back());
+				}
+				JsonBinder::_leave(lexer);
+			}
+			else
+				static_assert(!std::is_same_v<T, T>, "This type cannot be bound to Json. Describe it with JJYOU_JSON_DESCRIBE.");
+		}
+
+		template <class JsonTy> template <class T>
+		void JsonBinder<JsonTy>::_readObject(Lexer& lexer, T& value) {
+			const auto fields = jjyouJsonDescribe(static_cast<const T*>(nullptr));
+			constexpr std::size_t numFields = std::tuple_size_v<std::remove_cvref_t<decltype(fields)>>;
+			JsonBinder::_enter(lexer, JsonBinder::_expect(lexer, JsonTokenType::Lbrace, "Expected an object."));
+			bool first = true;
+			// Members usually come in the order of the fields, so the search starts after the last match.
+			std::size_t hint = 0;
+			while (JsonBinder::_next(lexer, JsonTokenType::Rbrace, first)) {
+				Token key = JsonBinder::_expect(lexer, JsonTokenType::String, "Object's key must be a string.");
+				std::size_t field = numFields;
+				std::apply([&](const auto&... descriptions) -> void {
+					const char* names[] = { descriptions.name... };
+					for (std::size_t i = 0; i < numFields && field == numFields; ++i)
+						if (JsonBinder::_equals(names[(hint + i) % numFields], key.view()))
+							field = (hint + i) % numFields;
+				}, fields);
+				JsonBinder::_expect(lexer, JsonTokenType::Colon, "Missing colon to separate key and value.");
+				if (field == numFields) {
+					_Skipper skipper;
+					DomType::_sax(lexer, skipper);
+					continue;
+				}
+				[&]<std::size_t... I>(std::index_sequence<I...>) -> void {
+					((I == field ? JsonBinder::_read(lexer, value.*std::get<I>(fields).member) : void()), ...);
+				}(std::make_index_sequence<numFields>());
+				hint = field + 1;
+			}
+			JsonBinder::_leave(lexer);
+		}
+
+		template <class JsonTy> template <class T>
+		void JsonBinder<JsonTy>::_readEigen(Lexer& lexer, T& value) {
+			using Scalar = typename T::Scalar;
+			constexpr bool isVector = (T::RowsAtCompileTime == 1 || T::ColsAtCompileTime == 1);
+			constexpr bool isFixed = (T::RowsAtCompileTime > 0 && T::ColsAtCompileTime > 0);
+			Token open = JsonBinder::_expect(lexer, JsonTokenType::Lbracket, "Expected an array.");
+			JsonBinder::_enter(lexer, open);
+			bool first = true;
+			if constexpr (isVector) {
+				std::vector<Scalar> elements;
+				while (JsonBinder::_next(lexer, JsonTokenType::Rbracket, first))
+					JsonBinder::_read(lexer, elements.emplace_back());
+				if constexpr (isFixed) {
+					if (elements.size() != static_cast<std::size_t>(T::RowsAtCompileTime * T::ColsAtCompileTime))
+						JsonBinder::_error(lexer, open, "Wrong number of elements in a fixed-size Eigen vector.");
+				}
+				else
+					value.resize(static_cast<decltype(value.size())>(elements.size()));
+				for (std::size_t i = 0; i < elements.size(); ++i)
+					value(static_cast<decltype(value.size())>(i)) = elements[i];
+			}
+			else {
+				std::vector<std::vector<Scalar>> rows;
+				while (JsonBinder::_next(lexer, JsonTokenType::Rbracket, first))
+					JsonBinder::_read(lexer, rows.emplace_back());
+				std::size_t cols = rows.empty() ? 0 : rows.front().size();
+				for (const std::vector<Scalar>& row : rows)
+					if (row.size() != cols)
+						JsonBinder::_error(lexer, open, "The rows of an Eigen matrix have different lengths.");
+				if constexpr (isFixed) {
+					if (rows.size() != static_cast<std::size_t>(T::RowsAtCompileTime) || cols != static_cast<std::size_t>(T::ColsAtCompileTime))
+						JsonBinder::_error(lexer, open, "Wrong size of a fixed-size Eigen matrix.");
+				}
+				else
+					value.resize(static_cast<decltype(value.rows())>(rows.size()), static_cast<decltype(value.cols())>(cols));
+				for (std::size_t r = 0; r < rows.size(); ++r)
+					for (std::size_t c = 0; c < cols; ++c)
+						value(static_cast<decltype(value.rows())>(r), static_cast<decltype(value.cols())>(c)) = rows[r][c];
+			}
+			JsonBinder::_leave(lexer);
+		}
+
+		template <class JsonTy> template <class HandlerTy>
+		inline void JsonBinder<JsonTy>::_key(const char* name, HandlerTy& handler) {
+			if constexpr (std::is_same_v<CharType, char>)
+				handler.onKey(StringViewType(name));
+			else {
+				StringType key{};
+				for (; *name != '\0'; ++name)
+					key.push_back(static_cast<CharType>(*name));
+				handler.onKey(StringViewType(key));
+			}
+		}
+
+		template <class JsonTy> template <class HandlerTy>
+		inline void JsonBinder<JsonTy>::_startArray(std::size_t size, HandlerTy& handler) {
+			// Handlers that need the size up front, such as `JsonBinaryWriter`, accept it.
+			if constexpr (requires { handler.onStartArray(std::size_t()); })
+				handler.onStartArray(size);
+			else
+				handler.onStartArray();
+		}
+
+		template <class JsonTy> template <class T, class HandlerTy>
+		void JsonBinder<JsonTy>::emit(const T& value, HandlerTy& handler) {
+			if constexpr (std::is_same_v<T, DomType>) {
+				value.emit(handler);
+			}
+			else if constexpr (std::is_same_v<T, bool>) {
+				handler.onBool(static_cast<typename DomType::BoolType>(value));
+			}
+			else if constexpr (std::is_enum_v<T>) {
+				JsonBinder::emit(static_cast<std::underlying_type_t<T>>(value), handler);
+			}
+			else if constexpr (std::is_integral_v<T>) {
+				using IntegerType = typename DomType::IntegerType;
+				// `std::in_range` does not accept character types.
+				using RangeType = std::conditional_t<std::is_signed_v<T>, std::make_signed_t<T>, std::make_unsigned_t<T>>;
+				const RangeType integer = static_cast<RangeType>(value);
+				// Handlers that accept any integer, such as `JsonSerializer`, get it unchanged.
+				if constexpr (requires { handler.template onInteger<RangeType>(integer); })
+					handler.template onInteger<RangeType>(integer);
+				else {
+					if constexpr (std::is_integral_v<IntegerType>) {
+						if (!std::in_range<IntegerType>(integer))
+							throw std::out_of_range("`JsonBinder::emit` got an integer out of the range of IntegerType.");
+					}
+					handler.onInteger(static_cast<IntegerType>(integer));
+				}
+			}
+			else if constexpr (std::is_floating_point_v<T>) {
+				handler.onFloating(static_cast<typename DomType::FloatingType>(value));
+			}
+			else if constexpr (_isString<T>) {
+				handler.onString(StringViewType(value.data(), value.size()));
+			}
+			else if constexpr (_IsOptional<T>::value) {
+				if (value.has_value())
+					JsonBinder::emit(*value, handler);
+				else
+					handler.onNull();
+			}
+			else if constexpr (JsonDescribed<T>) {
+				const auto fields = jjyouJsonDescribe(static_cast<const T*>(nullptr));
+				if constexpr (requires { handler.onStartObject(std::size_t()); })
+					handler.onStartObject(std::tuple_size_v<std::remove_cvref_t<decltype(fields)>>);
+				else
+					handler.onStartObject();
+				std::apply([&](const auto&... descriptions) -> void {
+					((JsonBinder::_key(descriptions.name, handler), JsonBinder::emit(value.*descriptions.member, handler)), ...);
+				}, fields);
+				handler.onEndObject();
+			}
+			else if constexpr (_Fixed<T>::value) {
+				JsonBinder::_startArray(_Fixed<T>::size, handler);
+				for (std::size_t i = 0; i < _Fixed<T>::size; ++i)
+					JsonBinder::emit(value[i], handler);
+				handler.onEndArray();
+			}
+			else if constexpr (_isEigen<T>) {
+				if constexpr (T::RowsAtCompileTime == 1 || T::ColsAtCompileTime == 1) {
+					JsonBinder::_startArray(static_cast<std::size_t>(value.size()), handler);
+					for (decltype(value.size()) i = 0; i < value.size(); ++i)
+						JsonBinder::emit(value(i), handler);
+					handler.onEndArray();
+				}
+				else {
+					JsonBinder::_startArray(static_cast<std::size_t>(value.rows()), handler);
+					for (decltype(value.rows()) r = 0; r < value.rows(); ++r) {
+						JsonBinder::_startArray(static_cast<std::size_t>(value.cols()), handler);
+						for (decltype(value.cols()) c = 0; c < value.cols(); ++c)
+							JsonBinder::emit(value(r, c), handler);
+						handler.onEndArray();
+					}
+					handler.onEndArray();
+				}
+			}
+			else if constexpr (requires { typename T::key_type; typename T::mapped_type; std::declval<T&>().try_emplace(std::declval<typename T::key_type>()); }) {
+				static_assert(_isString<typename T::key_type>, "The key type of a map bound to a Json object must be a string.");
+				if constexpr (requires { handler.onStartObject(std::size_t()); })
+					handler.onStartObject(value.size());
+				else
+					handler.onStartObject();
+				for (const auto& [key, mapped] : value) {
+					handler.onKey(StringViewType(key.data(), key.size()));
+					JsonBinder::emit(mapped, handler);
+				}
+				handler.onEndObject();
+			}
+			else if constexpr (requires { typename T::value_type; std::size(value); }) {
+				JsonBinder::_startArray(std::size(value), handler);
+				for (const auto& element : value)
+					JsonBinder::emit(static_cast<const typename T::value_type&>(element), handler);
+				handler.onEndArray();
+			}
+			else
+				static_assert(!std::is_same_v<T, T>, "This type cannot be bound to Json. Describe it with JJYOU_JSON_DESCRIBE.");
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonBind_hpp */
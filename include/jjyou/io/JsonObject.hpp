@@ -0,0 +1,603 @@
+/***********************************************************************
+ * @file	JsonObject.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements the object storage policies of Json class.
+***********************************************************************/
+#ifndef jjyou_io_JsonObject_hpp
+#define jjyou_io_JsonObject_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <compare>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @class	JsonMapIterator
+		 * @brief	Iterator of `JsonFlatMap` and `JsonOrderedMap`.
+		 *
+		 * The maps store `std::pair<KeyTy, ValueTy>` in a vector, so that pairs can be
+		 * moved when the vector is modified. Like `std::flat_map`, the iterators give access
+		 * to them through the proxy `std::pair<const KeyTy&, ValueTy&>`, so that keys cannot
+		 * be modified and break the order or the index of the map.
+		 *
+		 * @tparam	BaseIterTy	The iterator of the vector.
+		 * @tparam	KeyTy		The key type.
+		 * @tparam	ValueTy		The mapped type, const-qualified for const iterators.
+		 ***********************************************************************/
+		template <class BaseIterTy, class KeyTy, class ValueTy>
+		class JsonMapIterator {
+
+		public:
+
+			/** @name	Type definitions.
+			  */
+			//@{
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+			using value_type = std::pair<KeyTy, std::remove_const_t<ValueTy>>;
+			using difference_type = std::ptrdiff_t;
+			using reference = std::pair<const KeyTy&, ValueTy&>;
+			//@}
+
+			/** @brief	Pointer returned by `operator->`, which holds the proxy reference.
+			  */
+			struct pointer {
+				reference ref;
+				const reference* operator->() const { return std::addressof(this->ref); }
+			};
+
+			/** @brief	Construct a singular iterator.
+			  */
+			JsonMapIterator(void) = default;
+
+			/** @brief	Construct an iterator from the iterator of the vector.
+			  */
+			explicit JsonMapIterator(BaseIterTy base) : _base(base) {}
+
+			/** @brief	Convert an iterator to a const iterator.
+			  */
+			template <class OtherIterTy, class OtherValueTy> requires std::is_convertible_v<OtherIterTy, BaseIterTy>
+			JsonMapIterator(const JsonMapIterator<OtherIterTy, KeyTy, OtherValueTy>& other) : _base(other.base()) {}
+
+			/** @brief	Get the iterator of the vector.
+			  */
+			BaseIterTy base(void) const { return this->_base; }
+
+			/** @name	Access.
+			  */
+			//@{
+			reference operator*() const { return reference(this->_base->first, this->_base->second); }
+			pointer operator->() const { return pointer{ **this }; }
+			reference operator[](difference_type n) const { return *(*this + n); }
+			//@}
+
+			/** @name	Arithmetic.
+			  */
+			//@{
+			JsonMapIterator& operator++(void) { ++this->_base; return *this; }
+			JsonMapIterator operator++(int) { return JsonMapIterator(this->_base++); }
+			JsonMapIterator& operator--(void) { --this->_base; return *this; }
+			JsonMapIterator operator--(int) { return JsonMapIterator(this->_base--); }
+			JsonMapIterator& operator+=(difference_type n) { this->_base += n; return *this; }
+			JsonMapIterator& operator-=(difference_type n) { this->_base -= n; return *this; }
+			friend JsonMapIterator operator+(JsonMapIterator iter, difference_type n) { return iter += n; }
+			friend JsonMapIterator operator+(difference_type n, JsonMapIterator iter) { return iter += n; }
+			friend JsonMapIterator operator-(JsonMapIterator iter, difference_type n) { return iter -= n; }
+			friend difference_type operator-(const JsonMapIterator& iter1, const JsonMapIterator& iter2) { return iter1._base - iter2._base; }
+			//@}
+
+			/** @name	Comparison.
+			  */
+			//@{
+			friend bool operator==(const JsonMapIterator& iter1, const JsonMapIterator& iter2) { return iter1._base == iter2._base; }
+			friend std::strong_ordering operator<=>(const JsonMapIterator& iter1, const JsonMapIterator& iter2) { return iter1._base <=> iter2._base; }
+			//@}
+
+		private:
+
+			BaseIterTy _base{};
+
+		};
+
+		/***********************************************************************
+		 * @class	JsonFlatMap
+		 * @brief	Associative container that stores key-value pairs in a vector
+		 *			sorted by key.
+		 *
+		 * Lookup is a binary search over contiguous storage, and iteration follows
+		 * the key order like `std::map`. Inserting a key that is greater than all
+		 * existing keys is an append. Any other insertion or erasure moves the
+		 * following elements, so this container is best for small objects.
+		 * Unlike `std::map`, inserting or erasing invalidates all iterators.
+		 ***********************************************************************/
+		template <class KeyTy, class ValueTy, class AllocatorTy = std::allocator<std::pair<KeyTy, ValueTy>>>
+		class JsonFlatMap {
+
+		public:
+
+			/** @name	Type definitions.
+			  */
+			//@{
+			using key_type = KeyTy;
+			using mapped_type = ValueTy;
+			using value_type = std::pair<KeyTy, ValueTy>;
+			using reference = std::pair<const KeyTy&, ValueTy&>;
+			using const_reference = std::pair<const KeyTy&, const ValueTy&>;
+			using allocator_type = typename std::allocator_traits<AllocatorTy>::template rebind_alloc<value_type>;
+			using container_type = std::vector<value_type, allocator_type>;
+			using size_type = std::size_t;
+			using iterator = JsonMapIterator<typename container_type::iterator, KeyTy, ValueTy>;
+			using const_iterator = JsonMapIterator<typename container_type::const_iterator, KeyTy, const ValueTy>;
+			//@}
+
+			/** @brief	Construct an empty map.
+			  */
+			JsonFlatMap(void) = default;
+
+			/** @brief	Construct an empty map with the given allocator.
+			  */
+			explicit JsonFlatMap(const allocator_type& allocator) : _data(allocator) {}
+
+			/** @brief	Iterators in key order.
+			  */
+			iterator begin(void) { return iterator(this->_data.begin()); }
+			const_iterator begin(void) const { return const_iterator(this->_data.begin()); }
+			const_iterator cbegin(void) const { return const_iterator(this->_data.cbegin()); }
+			iterator end(void) { return iterator(this->_data.end()); }
+			const_iterator end(void) const { return const_iterator(this->_data.end()); }
+			const_iterator cend(void) const { return const_iterator(this->_data.cend()); }
+
+			/** @brief	Get the number of key-value pairs.
+			  */
+			size_type size(void) const { return this->_data.size(); }
+
+			/** @brief	Check whether the map is empty.
+			  */
+			bool empty(void) const { return this->_data.empty(); }
+
+			/** @brief	Remove all key-value pairs.
+			  */
+			void clear(void) { this->_data.clear(); }
+
+			/** @brief	Reserve storage for `count` key-value pairs.
+			  */
+			void reserve(size_type count) { this->_data.reserve(count); }
+
+			/** @brief	Find the value that is mapped to the given key.
+			  * @return	The iterator to the key-value pair, or `end()` if not found.
+			  */
+			iterator find(const key_type& key);
+			const_iterator find(const key_type& key) const;
+
+			/** @brief	Check whether the map contains the given key.
+			  */
+			bool contains(const key_type& key) const { return this->find(key) != this->end(); }
+
+			/** @brief	Get the number of pairs with the given key (0 or 1).
+			  */
+			size_type count(const key_type& key) const { return this->contains(key) ? 1 : 0; }
+
+			/** @brief	Get the value that is mapped to the given key, with bounds checking.
+			  *
+			  * An exception of type std::out_of_range is thrown if the key does not exist.
+			  */
+			mapped_type& at(const key_type& key);
+			const mapped_type& at(const key_type& key) const;
+
+			/** @brief	Get the value that is mapped to the given key,
+			  *			performing an insertion if such key does not already exist.
+			  */
+			mapped_type& operator[](const key_type& key) { return this->try_emplace(key).first->second; }
+			mapped_type& operator[](key_type&& key) { return this->try_emplace(std::move(key)).first->second; }
+
+			/** @brief	Insert a key-value pair constructed from `args` if the key does not exist.
+			  * @return	The iterator to the pair with the key, and `true` if the insertion took place.
+			  */
+			template <class K, class... Args>
+			std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+
+			/** @brief	Same as `try_emplace`. Existing values are not overwritten.
+			  */
+			template <class K, class... Args>
+			std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+				return this->try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+			}
+
+			/** @brief	Erase the key-value pair at `pos`.
+			  * @return	The iterator following the erased pair.
+			  */
+			iterator erase(const_iterator pos) { return iterator(this->_data.erase(pos.base())); }
+
+			/** @brief	Erase the key-value pair with the given key.
+			  * @return	The number of erased pairs (0 or 1).
+			  */
+			size_type erase(const key_type& key);
+
+			/** @brief	Move the key-value pairs out of the map, which is left empty.
+			  *
+			  * The keys of the returned pairs are not const, so they can be moved.
+			  */
+			container_type release(void) {
+				container_type res = std::move(this->_data);
+				this->clear();
+				return res;
+			}
+
+			/** @brief	Compare two maps.
+			  */
+			friend bool operator==(const JsonFlatMap& map1, const JsonFlatMap& map2) { return map1._data == map2._data; }
+
+		private:
+
+			container_type _data;
+
+			typename container_type::const_iterator _lowerBound(const key_type& key) const;
+
+		};
+
+		/***********************************************************************
+		 * @class	JsonOrderedMap
+		 * @brief	Associative container that keeps key-value pairs in insertion order.
+		 *
+		 * The pairs are stored contiguously in a vector. Objects with few members
+		 * are searched linearly, without hashing. Larger objects additionally keep
+		 * an open-addressing hash table (linear probing) of indices into the vector.
+		 * Erasing a pair keeps the order of the remaining pairs but rebuilds the
+		 * table. Inserting or erasing invalidates all iterators.
+		 * Two maps are equal if they contain the same pairs, in any order.
+		 ***********************************************************************/
+		template <class KeyTy, class ValueTy, class AllocatorTy = std::allocator<std::pair<KeyTy, ValueTy>>, class HashTy = std::hash<KeyTy>>
+		class JsonOrderedMap {
+
+		public:
+
+			/** @name	Type definitions.
+			  */
+			//@{
+			using key_type = KeyTy;
+			using mapped_type = ValueTy;
+			using value_type = std::pair<KeyTy, ValueTy>;
+			using reference = std::pair<const KeyTy&, ValueTy&>;
+			using const_reference = std::pair<const KeyTy&, const ValueTy&>;
+			using hasher = HashTy;
+			using allocator_type = typename std::allocator_traits<AllocatorTy>::template rebind_alloc<value_type>;
+			using container_type = std::vector<value_type, allocator_type>;
+			using size_type = std::size_t;
+			using iterator = JsonMapIterator<typename container_type::iterator, KeyTy, ValueTy>;
+			using const_iterator = JsonMapIterator<typename container_type::const_iterator, KeyTy, const ValueTy>;
+			//@}
+
+			/** @brief	Objects with at most this number of members are searched linearly.
+			  */
+			static constexpr size_type linearSearchLimit = 8;
+
+			/** @brief	Construct an empty map.
+			  */
+			JsonOrderedMap(void) = default;
+
+			/** @brief	Construct an empty map with the given allocator.
+			  */
+			explicit JsonOrderedMap(const allocator_type& allocator) : _data(allocator), _slots(_SlotAllocator(allocator)) {}
+
+			/** @brief	Iterators in insertion order.
+			  */
+			iterator begin(void) { return iterator(this->_data.begin()); }
+			const_iterator begin(void) const { return const_iterator(this->_data.begin()); }
+			const_iterator cbegin(void) const { return const_iterator(this->_data.cbegin()); }
+			iterator end(void) { return iterator(this->_data.end()); }
+			const_iterator end(void) const { return const_iterator(this->_data.end()); }
+			const_iterator cend(void) const { return const_iterator(this->_data.cend()); }
+
+			/** @brief	Get the number of key-value pairs.
+			  */
+			size_type size(void) const { return this->_data.size(); }
+
+			/** @brief	Check whether the map is empty.
+			  */
+			bool empty(void) const { return this->_data.empty(); }
+
+			/** @brief	Remove all key-value pairs.
+			  */
+			void clear(void) { this->_data.clear(); this->_slots.clear(); }
+
+			/** @brief	Reserve storage for `count` key-value pairs.
+			  */
+			void reserve(size_type count) { this->_data.reserve(count); }
+
+			/** @brief	Find the value that is mapped to the given key.
+			  * @return	The iterator to the key-value pair, or `end()` if not found.
+			  */
+			iterator find(const key_type& key) { return this->begin() + this->_find(key); }
+			const_iterator find(const key_type& key) const { return this->begin() + this->_find(key); }
+
+			/** @brief	Check whether the map contains the given key.
+			  */
+			bool contains(const key_type& key) const { return this->_find(key) != this->_data.size(); }
+
+			/** @brief	Get the number of pairs with the given key (0 or 1).
+			  */
+			size_type count(const key_type& key) const { return this->contains(key) ? 1 : 0; }
+
+			/** @brief	Get the value that is mapped to the given key, with bounds checking.
+			  *
+			  * An exception of type std::out_of_range is thrown if the key does not exist.
+			  */
+			mapped_type& at(const key_type& key);
+			const mapped_type& at(const key_type& key) const;
+
+			/** @brief	Get the value that is mapped to the given key,
+			  *			performing an insertion if such key does not already exist.
+			  */
+			mapped_type& operator[](const key_type& key) { return this->try_emplace(key).first->second; }
+			mapped_type& operator[](key_type&& key) { return this->try_emplace(std::move(key)).first->second; }
+
+			/** @brief	Append a key-value pair constructed from `args` if the key does not exist.
+			  * @return	The iterator to the pair with the key, and `true` if the insertion took place.
+			  */
+			template <class K, class... Args>
+			std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+
+			/** @brief	Same as `try_emplace`. Existing values are not overwritten.
+			  */
+			template <class K, class... Args>
+			std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+				return this->try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+			}
+
+			/** @brief	Erase the key-value pair at `pos`.
+			  * @return	The iterator following the erased pair.
+			  */
+			iterator erase(const_iterator pos);
+
+			/** @brief	Erase the key-value pair with the given key.
+			  * @return	The number of erased pairs (0 or 1).
+			  */
+			size_type erase(const key_type& key);
+
+			/** @brief	Move the key-value pairs out of the map, which is left empty.
+			  *
+			  * The keys of the returned pairs are not const, so they can be moved.
+			  */
+			container_type release(void) {
+				container_type res = std::move(this->_data);
+				this->clear();
+				return res;
+			}
+
+			/** @brief	Compare two maps, ignoring the insertion order.
+			  */
+			friend bool operator==(const JsonOrderedMap& map1, const JsonOrderedMap& map2) {
+				if (map1.size() != map2.size())
+					return false;
+				for (const_reference p : map1) {
+					const_iterator iter = map2.find(p.first);
+					if (iter == map2.end() || !(iter->second == p.second))
+						return false;
+				}
+				return true;
+			}
+
+		private:
+
+			using _SlotAllocator = typename std::allocator_traits<AllocatorTy>::template rebind_alloc<std::uint32_t>;
+
+			container_type _data;
+
+			// Open-addressing table of `index + 1` into `_data`, 0 for empty slots.
+			// Empty as long as the map is small enough for linear search.
+			std::vector<std::uint32_t, _SlotAllocator> _slots;
+
+			size_type _find(const key_type& key) const;
+
+			void _insertSlot(size_type index);
+
+			void _rehash(void);
+
+		};
+
+		/***********************************************************************
+		 * @brief	Object storage policies of `Json`.
+		 *
+		 * A policy is passed as the `ObjectPolicyTy` template argument of `Json` and
+		 * selects the container type of `Json::ObjectType` through its member alias
+		 * template `type<KeyTy, ValueTy, AllocatorTy>`. All policies provide the same
+		 * `std::map`-like interface (iterators, `find`, `at`, `operator[]`, `emplace`,
+		 * `erase`, `operator==`), so Json behaves the same apart from the member order.
+		 *
+		 *  - `JsonMapObject`: `std::map`, sorted by key. One allocation per member.
+		 *  - `JsonFlatObject`: `JsonFlatMap`, sorted by key, contiguous storage.
+		 *  - `JsonOrderedObject`: `JsonOrderedMap`, insertion (i.e. document) order.
+		 ***********************************************************************/
+		struct JsonMapObject {
+			template <class KeyTy, class ValueTy, class AllocatorTy>
+			using type = std::map<KeyTy, ValueTy, std::less<KeyTy>, typename std::allocator_traits<AllocatorTy>::template rebind_alloc<std::pair<const KeyTy, ValueTy>>>;
+		};
+		struct JsonFlatObject {
+			template <class KeyTy, class ValueTy, class AllocatorTy>
+			using type = JsonFlatMap<KeyTy, ValueTy, AllocatorTy>;
+		};
+		struct JsonOrderedObject {
+			template <class KeyTy, class ValueTy, class AllocatorTy>
+			using type = JsonOrderedMap<KeyTy, ValueTy, AllocatorTy>;
+		};
+
+	}
+
+}
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class KeyTy, class ValueTy, class AllocatorTy>
+		inline typename JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::container_type::const_iterator JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::_lowerBound(const key_type& key) const {
+			return std::lower_bound(this->_data.cbegin(), this->_data.cend(), key,
+				[](const value_type& p, const key_type& k) -> bool { return p.first < k; });
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy>
+		inline typename JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::iterator JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::find(const key_type& key) {
+			typename container_type::const_iterator iter = this->_lowerBound(key);
+			if (iter == this->_data.cend() || key < iter->first)
+				return this->end();
+			return this->begin() + (iter - this->_data.cbegin());
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy>
+		inline typename JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::const_iterator JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::find(const key_type& key) const {
+			typename container_type::const_iterator iter = this->_lowerBound(key);
+			if (iter == this->_data.cend() || key < iter->first)
+				return this->cend();
+			return const_iterator(iter);
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy>
+		inline typename JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::mapped_type& JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::at(const key_type& key) {
+			iterator iter = this->find(key);
+			if (iter == this->end())
+				throw std::out_of_range("`JsonFlatMap::at(const key_type&)` key not found.");
+			return iter->second;
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy>
+		inline const typename JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::mapped_type& JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::at(const key_type& key) const {
+			const_iterator iter = this->find(key);
+			if (iter == this->cend())
+				throw std::out_of_range("`JsonFlatMap::at(const key_type&) const` key not found.");
+			return iter->second;
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy> template <class K, class... Args>
+		inline std::pair<typename JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::iterator, bool> JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::try_emplace(K&& key, Args&&... args) {
+			// Members of parsed objects are often already sorted. Append them directly.
+			if (this->_data.empty() || this->_data.back().first < key) {
+				this->_data.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+				return { this->end() - 1, true };
+			}
+			typename container_type::const_iterator iter = this->_lowerBound(key);
+			if (!(key < iter->first))
+				return { this->begin() + (iter - this->_data.cbegin()), false };
+			return { iterator(this->_data.emplace(iter, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...))), true };
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy>
+		inline typename JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::size_type JsonFlatMap<KeyTy, ValueTy, AllocatorTy>::erase(const key_type& key) {
+			const_iterator iter = this->find(key);
+			if (iter == this->cend())
+				return 0;
+			this->erase(iter);
+			return 1;
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy>
+		inline typename JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::size_type JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::_find(const key_type& key) const {
+			if (this->_slots.empty()) {
+				for (size_type i = 0; i < this->_data.size(); ++i)
+					if (this->_data[i].first == key)
+						return i;
+				return this->_data.size();
+			}
+			const size_type mask = this->_slots.size() - 1;
+			for (size_type slot = hasher{}(key) & mask; this->_slots[slot] != 0; slot = (slot + 1) & mask) {
+				size_type index = this->_slots[slot] - 1;
+				if (this->_data[index].first == key)
+					return index;
+			}
+			return this->_data.size();
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy>
+		inline void JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::_insertSlot(size_type index) {
+			const size_type mask = this->_slots.size() - 1;
+			size_type slot = hasher{}(this->_data[index].first) & mask;
+			while (this->_slots[slot] != 0)
+				slot = (slot + 1) & mask;
+			this->_slots[slot] = static_cast<std::uint32_t>(index + 1);
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy>
+		inline void JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::_rehash(void) {
+			if (this->_data.size() <= linearSearchLimit) {
+				this->_slots.clear();
+				return;
+			}
+			// Keep the load factor at most 1/2.
+			size_type capacity = 16;
+			while (capacity < this->_data.size() * 2)
+				capacity *= 2;
+			this->_slots.assign(capacity, 0);
+			for (size_type i = 0; i < this->_data.size(); ++i)
+				this->_insertSlot(i);
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy>
+		inline typename JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::mapped_type& JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::at(const key_type& key) {
+			size_type index = this->_find(key);
+			if (index == this->_data.size())
+				throw std::out_of_range("`JsonOrderedMap::at(const key_type&)` key not found.");
+			return this->_data[index].second;
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy>
+		inline const typename JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::mapped_type& JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::at(const key_type& key) const {
+			size_type index = this->_find(key);
+			if (index == this->_data.size())
+				throw std::out_of_range("`JsonOrderedMap::at(const key_type&) const` key not found.");
+			return this->_data[index].second;
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy> template <class K, class... Args>
+		inline std::pair<typename JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::iterator, bool> JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::try_emplace(K&& key, Args&&... args) {
+			size_type index = this->_find(key);
+			if (index != this->_data.size())
+				return { this->begin() + index, false };
+			this->_data.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+			if (this->_slots.empty() ? this->_data.size() > linearSearchLimit : this->_data.size() * 2 > this->_slots.size())
+				this->_rehash();
+			else if (!this->_slots.empty())
+				this->_insertSlot(index);
+			return { this->begin() + index, true };
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy>
+		inline typename JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::iterator JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::erase(const_iterator pos) {
+			size_type index = pos.base() - this->_data.cbegin();
+			this->_data.erase(pos.base());
+			this->_rehash();
+			return this->begin() + index;
+		}
+
+		template <class KeyTy, class ValueTy, class AllocatorTy, class HashTy>
+		inline typename JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::size_type JsonOrderedMap<KeyTy, ValueTy, AllocatorTy, HashTy>::erase(const key_type& key) {
+			size_type index = this->_find(key);
+			if (index == this->_data.size())
+				return 0;
+			this->erase(this->cbegin() + index);
+			return 1;
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonObject_hpp */
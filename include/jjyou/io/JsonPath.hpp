@@ -0,0 +1,357 @@
+/***********************************************************************
+ * @file	JsonPath.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements JsonPath class.
+***********************************************************************/
+#ifndef jjyou_io_JsonPath_hpp
+#define jjyou_io_JsonPath_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include "Json.hpp"
+#include "JsonView.hpp"
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @class	JsonPath
+		 * @brief	A set of JSON Pointers (RFC 6901) compiled for repeated queries.
+		 *
+		 * Each pointer is parsed once into reference tokens, with their keys and
+		 * array indices decoded, so that evaluating it neither builds keys nor
+		 * parses the pointer again. The pointers are merged into a prefix tree,
+		 * and all of them are evaluated in one traversal of the document: shared
+		 * prefixes are visited once, and the arrays and objects of a `JsonView`
+		 * are scanned once for all the tokens that apply to them.
+		 *
+		 * Besides the RFC 6901 syntax ("" is the whole document, "/a/0/b~1c" is
+		 * member "a", element 0, member "b/c"), a token `*` matches every element
+		 * of an array and every member of an object. A member whose key is `*`
+		 * is written `~2`.
+		 *
+		 * @tparam	IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy	Same as `Json`.
+		 ***********************************************************************/
+		template <
+			class IntegerTy = int,
+			class FloatingTy = float,
+			class StringTy = std::string,
+			class BoolTy = bool,
+			class ObjectPolicyTy = JsonMapObject
+		>
+		class JsonPath {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using DomType = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using ViewType = JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using CharType = typename DomType::CharType;
+			using StringType = typename JsonOwningString<StringTy>::type;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Default constructor. Create a path without pointers.
+			  */
+			JsonPath(void) : _nodes(1) {}
+
+			/** @brief	Compile one pointer.
+			  */
+			explicit JsonPath(StringViewType pointer) : JsonPath() {
+				this->add(pointer);
+			}
+
+			/** @brief	Compile several pointers. Their indices are their positions in `pointers`.
+			  */
+			JsonPath(std::initializer_list<StringViewType> pointers) : JsonPath() {
+				for (StringViewType pointer : pointers)
+					this->add(pointer);
+			}
+
+			/** @brief	Compile a pointer and add it to the path.
+			  *
+			  * An exception of type std::runtime_error is thrown if the pointer is malformed.
+			  * @return	The index of the pointer, which identifies its matches.
+			  */
+			std::size_t add(StringViewType pointer);
+
+			/** @brief	Get the number of pointers.
+			  */
+			std::size_t size(void) const { return this->_numPointers; }
+
+			/** @brief	Evaluate all pointers against a Json container.
+			  *
+			  * `callback` is called as `callback(std::size_t index, const DomType& value)` for
+			  * every match, where `index` is the index of the matching pointer. Matches of
+			  * wildcards are reported in container order. Pointers that do not match, e.g.
+			  * because a member is missing or an index is out of range, are not reported.
+			  * Elements of packed arrays (see `Json::ParseOptions::packNumbers`) are read with
+			  * `Json::element()`, so their matches are only valid during the call.
+			  */
+			template <class F>
+			void evaluate(const DomType& json, F&& callback) const {
+				this->_evaluate<false>(json, 0, callback);
+			}
+
+			/** @brief	Evaluate all pointers against a lazy view, in one scan of the visited containers.
+			  *
+			  * `callback` is called as `callback(std::size_t index, const ViewType& value)`.
+			  * If an object has duplicate keys, a key token matches the first member, as in
+			  * `Json::parse`, while a wildcard visits every member in document order.
+			  */
+			template <class F>
+			void evaluate(const ViewType& view, F&& callback) const {
+				this->_evaluate(view, 0, callback);
+			}
+
+			/** @brief	Evaluate all pointers and collect the matches of each pointer.
+			  *
+			  * Matches in packed arrays point to the elements built by their const accessors.
+			  * @return	`res[i]` holds the matches of pointer `i`. Without wildcards, it has at most one element.
+			  */
+			std::vector<std::vector<const DomType*>> extract(const DomType& json) const {
+				std::vector<std::vector<const DomType*>> res(this->size());
+				auto callback = [&res](std::size_t index, const DomType& value) -> void { res[index].push_back(&value); };
+				this->_evaluate<true>(json, 0, callback);
+				return res;
+			}
+
+			/** @brief	Evaluate all pointers against a lazy view and collect the matches of each pointer.
+			  */
+			std::vector<std::vector<ViewType>> extract(const ViewType& view) const {
+				std::vector<std::vector<ViewType>> res(this->size());
+				this->evaluate(view, [&res](std::size_t index, const ViewType& value) -> void { res[index].push_back(value); });
+				return res;
+			}
+
+		private:
+
+			static constexpr std::size_t _noIndex = std::numeric_limits<std::size_t>::max();
+
+			struct _Node {
+				StringType key{};
+				// The array index denoted by `key`, or `_noIndex` if it is not one.
+				std::size_t index = _noIndex;
+				bool wildcard = false;
+				std::vector<std::size_t> children{};
+				// Indices of the pointers that end at this node.
+				std::vector<std::size_t> pointers{};
+			};
+
+			std::vector<_Node> _nodes;
+			std::size_t _numPointers = 0;
+
+			// With `stable`, the matches in packed arrays are their elements built by the const
+			// accessors, which outlive the call, instead of temporaries.
+			template <bool stable, class F>
+			void _evaluate(const DomType& json, std::size_t node, F& callback) const;
+			template <class F>
+			void _evaluate(const ViewType& view, std::size_t node, F& callback) const;
+
+		};
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::size_t JsonPath<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::add(StringViewType pointer) {
+			auto error = [&pointer](const char* message) -> void {
+				std::string text;
+				for (CharType c : pointer)
+					text.push_back(static_cast<char>(c));
+				throw std::runtime_error("[Json Pointer] \"" + text + "\" " + message);
+			};
+			if (!pointer.empty() && pointer.front() != static_cast<CharType>('/'))
+				error("A non-empty pointer must start with '/'.");
+			std::size_t node = 0;
+			std::size_t curr = 0;
+			while (curr != pointer.size()) {
+				// Decode the reference token after '/'.
+				++curr;
+				_Node token;
+				bool escaped = false;
+				for (; curr != pointer.size() && pointer[curr] != static_cast<CharType>('/'); ++curr) {
+					if (pointer[curr] != static_cast<CharType>('~')) {
+						token.key.push_back(pointer[curr]);
+						continue;
+					}
+					escaped = true;
+					CharType next = (curr + 1 != pointer.size()) ? pointer[++curr] : static_cast<CharType>('\0');
+					if (next == static_cast<CharType>('0'))
+						token.key.push_back(static_cast<CharType>('~'));
+					else if (next == static_cast<CharType>('1'))
+						token.key.push_back(static_cast<CharType>('/'));
+					else if (next == static_cast<CharType>('2'))
+						token.key.push_back(static_cast<CharType>('*'));
+					else
+						error("'~' must be followed by '0', '1' or '2'.");
+				}
+				token.wildcard = !escaped && token.key.size() == 1 && token.key[0] == static_cast<CharType>('*');
+				// Array indices are "0" or digits without a leading zero.
+				bool digits = !token.key.empty() && (token.key.size() == 1 || token.key[0] != static_cast<CharType>('0'));
+				std::size_t index = 0;
+				for (CharType c : token.key) {
+					if (c < static_cast<CharType>('0') || c > static_cast<CharType>('9') || index > (_noIndex - 9) / 10) {
+						digits = false;
+						break;
+					}
+					index = index * 10 + static_cast<std::size_t>(c - static_cast<CharType>('0'));
+				}
+				token.index = digits ? index : _noIndex;
+				// Share the node with an earlier pointer if it has the same token.
+				std::size_t child = 0;
+				for (child = 0; child < this->_nodes[node].children.size(); ++child) {
+					const _Node& other = this->_nodes[this->_nodes[node].children[child]];
+					if (other.wildcard == token.wildcard && other.key == token.key)
+						break;
+				}
+				if (child == this->_nodes[node].children.size()) {
+					this->_nodes[node].children.push_back(this->_nodes.size());
+					this->_nodes.push_back(std::move(token));
+				}
+				node = this->_nodes[node].children[child];
+			}
+			this->_nodes[node].pointers.push_back(this->_numPointers);
+			return this->_numPointers++;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <bool stable, class F>
+		void JsonPath<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_evaluate(const DomType& json, std::size_t node, F& callback) const {
+			const _Node& curr = this->_nodes[node];
+			for (std::size_t pointer : curr.pointers)
+				callback(pointer, json);
+			if (curr.children.empty())
+				return;
+			if (json.type() == JsonType::Array && !stable && json.packedType() != JsonType::Null) {
+				// Read the numbers without building the elements of the packed array.
+				for (std::size_t child : curr.children) {
+					const _Node& token = this->_nodes[child];
+					if (token.wildcard) {
+						for (std::size_t i = 0; i < json.size(); ++i)
+							this->_evaluate<stable>(json.element(i), child, callback);
+					}
+					else if (token.index < json.size()) {
+						this->_evaluate<stable>(json.element(token.index), child, callback);
+					}
+				}
+			}
+			else if (json.type() == JsonType::Array) {
+				const typename DomType::ArrayType& array = json.array();
+				for (std::size_t child : curr.children) {
+					const _Node& token = this->_nodes[child];
+					if (token.wildcard) {
+						for (const DomType& element : array)
+							this->_evaluate<stable>(element, child, callback);
+					}
+					else if (token.index < array.size()) {
+						this->_evaluate<stable>(array[token.index], child, callback);
+					}
+				}
+			}
+			else if (json.type() == JsonType::Object) {
+				const typename DomType::ObjectType& object = json.object();
+				for (std::size_t child : curr.children) {
+					const _Node& token = this->_nodes[child];
+					if (token.wildcard) {
+						for (const auto& member : object)
+							this->_evaluate<stable>(member.second, child, callback);
+					}
+					else {
+						typename DomType::ObjectType::const_iterator iter;
+						if constexpr (std::is_same_v<typename DomType::StringType, StringType>)
+							iter = object.find(token.key);
+						else
+							iter = object.find(typename DomType::StringType(token.key.data(), token.key.size()));
+						if (iter != object.end())
+							this->_evaluate<stable>(iter->second, child, callback);
+					}
+				}
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class F>
+		void JsonPath<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_evaluate(const ViewType& view, std::size_t node, F& callback) const {
+			const _Node& curr = this->_nodes[node];
+			for (std::size_t pointer : curr.pointers)
+				callback(pointer, view);
+			if (curr.children.empty())
+				return;
+			JsonType type = view.type();
+			if (type != JsonType::Array && type != JsonType::Object)
+				return;
+			// Scan the container once. Stop early once every non-wildcard token is resolved.
+			bool wildcard = false;
+			std::size_t remaining = 0;
+			for (std::size_t child : curr.children) {
+				const _Node& token = this->_nodes[child];
+				wildcard = wildcard || token.wildcard;
+				remaining += !token.wildcard && (type == JsonType::Object || token.index != _noIndex);
+			}
+			// Tokens that already matched, as a bit mask for the common case of few tokens.
+			std::uint64_t foundMask = 0;
+			std::vector<bool> found(curr.children.size() > 64 ? curr.children.size() : 0, false);
+			std::size_t position = 0;
+			for (auto iter = view.begin(); iter != view.end() && (wildcard || remaining != 0); ++iter, ++position) {
+				StringViewType key{};
+				StringType decoded{};
+				if (type == JsonType::Object) {
+					key = iter.rawKey();
+					if (key.find(static_cast<CharType>('\\')) != StringViewType::npos) {
+						decoded = StringType(iter.key());
+						key = StringViewType(decoded);
+					}
+				}
+				for (std::size_t i = 0; i < curr.children.size(); ++i) {
+					const _Node& token = this->_nodes[curr.children[i]];
+					bool match = false;
+					if (token.wildcard)
+						match = true;
+					else if (i < 64 ? ((foundMask >> i) & 1) != 0 : found[i])
+						match = false;
+					else if (type == JsonType::Array)
+						match = (token.index == position);
+					else
+						match = (key == StringViewType(token.key));
+					if (!match)
+						continue;
+					if (!token.wildcard) {
+						if (i < 64)
+							foundMask |= std::uint64_t(1) << i;
+						else
+							found[i] = true;
+						--remaining;
+					}
+					this->_evaluate(*iter, curr.children[i], callback);
+				}
+			}
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonPath_hpp */
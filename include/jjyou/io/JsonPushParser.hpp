@@ -0,0 +1,543 @@
+/***********************************************************************
+ * @file	JsonPushParser.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements JsonPushParser class.
+***********************************************************************/
+#ifndef jjyou_io_JsonPushParser_hpp
+#define jjyou_io_JsonPushParser_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include "Json.hpp"
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @class	JsonPushParser
+		 * @brief	Incremental parser of json that arrives in chunks.
+		 *
+		 * Chunks of any size, e.g. reads from a pipe or socket, are passed to
+		 * `feed`. Events are emitted as soon as the tokens they belong to are
+		 * complete, so a whole message never has to be buffered. Only a token
+		 * that is cut by the end of a chunk is copied, and only until the chunk
+		 * that completes it arrives. Between chunks, the parser keeps the stack
+		 * of open containers, the grammar state and the line, column and
+		 * position used in error messages.
+		 *
+		 * The grammar, the conversion of numbers and strings and the error
+		 * messages, including the nesting limit of `Options::maxDepth`, are the
+		 * same as `Json::parse`, except that data after the value is an error
+		 * unless `Options::multipleValues` is set. Exceptions of type
+		 * std::runtime_error are thrown for malformed input, after which the
+		 * parser must be `reset` before it is used again.
+		 *
+		 * @tparam	IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy	Same as `Json`.
+		 ***********************************************************************/
+		template <
+			class IntegerTy = int,
+			class FloatingTy = float,
+			class StringTy = std::string,
+			class BoolTy = bool,
+			class ObjectPolicyTy = JsonMapObject
+		>
+		class JsonPushParser {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using DomType = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using CharType = typename DomType::CharType;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Options that control how the input is parsed.
+			  */
+			struct Options {
+
+				/** @brief	Accept a sequence of values separated by optional whitespace, such as
+				  *			JSON Lines or back-to-back messages. Otherwise, anything but whitespace
+				  *			after the first value is an error.
+				  */
+				bool multipleValues = false;
+
+				/** @brief	Maximum nesting depth of arrays and objects, as `Json::ParseOptions::maxDepth`.
+				  *
+				  * The stack of open containers grows with the nesting of the input, so the
+				  * limit bounds the memory that a chunked input can make the parser hold.
+				  */
+				std::size_t maxDepth = typename DomType::ParseOptions().maxDepth;
+
+			};
+
+			/** @brief	Construct a parser with default options.
+			  */
+			JsonPushParser(void) : JsonPushParser(Options()) {}
+
+			/** @brief	Construct a parser.
+			  */
+			explicit JsonPushParser(const Options& options) : _options(options), _input(new _Input()) {
+				this->reset();
+			}
+
+			/** @brief	Parse the next chunk of the input and pass the completed events to `handler`.
+			  *
+			  * `handler` has the same member functions as the handler of `Json::sax`, and must
+			  * be the same object for all chunks of a value. Strings and keys are views that are
+			  * only valid during the call. The chunk is not used after `feed` returns.
+			  */
+			template <class HandlerTy>
+			void feed(StringViewType chunk, HandlerTy& handler) {
+				auto onValue = [](void) -> void {};
+				this->_feed(chunk, handler, onValue);
+			}
+
+			/** @brief	Mark the end of the input and pass the remaining events to `handler`.
+			  *
+			  * A number at the end of the input is only complete at this point. An exception
+			  * of type std::runtime_error is thrown if the input ends inside a value, or if it
+			  * has no value and `Options::multipleValues` is not set. Afterwards, the parser
+			  * is reset and can parse a new input.
+			  */
+			template <class HandlerTy>
+			void finish(HandlerTy& handler) {
+				auto onValue = [](void) -> void {};
+				this->_finish(handler, onValue);
+			}
+
+			/** @brief	Parse the next chunk of the input and build the values that it completes.
+			  *
+			  * `callback` is called as `callback(DomType&&)` for every top-level value as soon as
+			  * it is closed. Don't mix with `feed` for the same value.
+			  */
+			template <class F>
+			void feedValues(StringViewType chunk, F&& callback) {
+				if (!this->_builder)
+					this->_builder.emplace();
+				auto onValue = [&](void) -> void { callback(this->_builder->release()); };
+				this->_feed(chunk, *this->_builder, onValue);
+			}
+
+			/** @brief	Mark the end of the input and build the value that it completes, if any.
+			  */
+			template <class F>
+			void finishValues(F&& callback) {
+				if (!this->_builder)
+					this->_builder.emplace();
+				auto onValue = [&](void) -> void { callback(this->_builder->release()); };
+				this->_finish(*this->_builder, onValue);
+			}
+
+			/** @brief	Discard the state and start a new input.
+			  */
+			void reset(void);
+
+			/** @brief	Get the number of arrays and objects that are open.
+			  */
+			std::size_t depth(void) const { return this->_stack.size(); }
+
+			/** @name	Trace of the first character of the input that has not been parsed yet,
+			  *			counted from 0. A token that is cut by the end of a chunk is not parsed yet.
+			  */
+			//@{
+			std::size_t line(void) const { return this->_input->lexer.line; }
+			std::size_t col(void) const { return this->_input->lexer.col; }
+			std::size_t pos(void) const { return this->_input->lexer.pos; }
+			//@}
+
+		private:
+
+			using StringType = typename JsonOwningString<StringTy>::type;
+			using InputAdapter = JsonInputAdapter<StringType>;
+			using Lexer = JsonLexer<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using Token = JsonToken<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+
+			// The lexer refers to the adapter, so both are kept at a fixed address.
+			struct _Input {
+				InputAdapter adapter{ static_cast<const CharType*>(nullptr), static_cast<const CharType*>(nullptr) };
+				Lexer lexer{ adapter };
+			};
+
+			// What the grammar expects next.
+			enum class _State {
+				Value,
+				ValueOrEnd, // After '['.
+				KeyOrEnd, // After '{'.
+				Key,
+				Colon,
+				CommaOrEnd,
+				Done // After a top-level value.
+			};
+
+			Options _options{};
+			std::unique_ptr<_Input> _input;
+			_State _state = _State::Value;
+			// '[' or '{' for every open container.
+			std::vector<CharType> _stack{};
+			// The beginning of a token that was cut by the end of the previous chunk.
+			StringType _pending{};
+			bool _pendingString = false;
+			bool _pendingEscape = false;
+			std::optional<JsonDomBuilder<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>> _builder{};
+
+			template <class HandlerTy, class F>
+			void _feed(StringViewType chunk, HandlerTy& handler, F& onValue);
+			template <class HandlerTy, class F>
+			void _finish(HandlerTy& handler, F& onValue);
+			template <class HandlerTy, class F>
+			void _lex(const CharType* first, const CharType* last, bool final, HandlerTy& handler, F& onValue);
+			template <class HandlerTy, class F>
+			void _token(const Token& token, HandlerTy& handler, F& onValue);
+			const CharType* _continue(const CharType* first, const CharType* last, bool& complete);
+			static StringViewType _literal(CharType first);
+			static bool _isCut(const CharType* first, const CharType* last);
+			template <class... Args>
+			[[noreturn]] void _error(Token token, Args&&... args) const;
+
+		};
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::reset(void) {
+			this->_state = this->_options.multipleValues ? _State::Done : _State::Value;
+			this->_stack.clear();
+			this->_pending.clear();
+			this->_pendingString = false;
+			this->_pendingEscape = false;
+			this->_input->lexer.line = 0;
+			this->_input->lexer.col = 0;
+			this->_input->lexer.pos = 0;
+			if (this->_builder)
+				this->_builder.emplace();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class HandlerTy, class F>
+		inline void JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_feed(StringViewType chunk, HandlerTy& handler, F& onValue) {
+			const CharType* first = chunk.data();
+			const CharType* last = chunk.data() + chunk.size();
+			if (!this->_pending.empty()) {
+				// Complete the token that was cut by the end of the previous chunk.
+				bool complete = false;
+				const CharType* end = this->_continue(first, last, complete);
+				this->_pending.append(first, end);
+				if (!complete)
+					return;
+				StringType pending = std::move(this->_pending);
+				this->_pending.clear();
+				this->_lex(pending.data(), pending.data() + pending.size(), true, handler, onValue);
+				first = end;
+			}
+			this->_lex(first, last, false, handler, onValue);
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class HandlerTy, class F>
+		inline void JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_finish(HandlerTy& handler, F& onValue) {
+			if (!this->_pending.empty()) {
+				StringType pending = std::move(this->_pending);
+				this->_pending.clear();
+				this->_lex(pending.data(), pending.data() + pending.size(), true, handler, onValue);
+			}
+			if (this->_state != _State::Done) {
+				const Lexer& lexer = this->_input->lexer;
+				this->_error(Token(JsonTokenType::End, lexer.line, lexer.col, lexer.pos), "Unexpected EOF.");
+			}
+			this->reset();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class HandlerTy, class F>
+		void JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_lex(const CharType* first, const CharType* last, bool final, HandlerTy& handler, F& onValue) {
+			InputAdapter& adapter = this->_input->adapter;
+			Lexer& lexer = this->_input->lexer;
+			adapter.rangeBegin = adapter.rangeCurr = first;
+			adapter.rangeEnd = last;
+			lexer.mark = first;
+			while (true) {
+				const CharType* before = adapter.rangeCurr;
+				const std::size_t posBefore = lexer._pos();
+				Token token = lexer.get();
+				if (token.type == JsonTokenType::End) {
+					lexer._advanceMark();
+					return;
+				}
+				// Numbers, and tokens that are not complete yet, may go on in the next chunk.
+				// Strings, literals and punctuation end with a known character.
+				const CharType* tokenBegin = before + (token.pos - posBefore);
+				if (!final && adapter.rangeCurr == last && (
+					token.type == JsonTokenType::Integer ||
+					token.type == JsonTokenType::Floating ||
+					(token.type == JsonTokenType::Unexpected && JsonPushParser::_isCut(tokenBegin, last))
+				)) {
+					this->_pending.assign(tokenBegin, last);
+					this->_pendingString = (*tokenBegin == static_cast<CharType>('\"'));
+					this->_pendingEscape = false;
+					if (this->_pendingString) {
+						for (const CharType* curr = tokenBegin + 1; curr != last; ++curr)
+							this->_pendingEscape = !this->_pendingEscape && *curr == static_cast<CharType>('\\');
+					}
+					lexer._locate(token);
+					lexer.line = token.line;
+					lexer.col = token.col;
+					lexer.pos = token.pos;
+					return;
+				}
+				this->_token(token, handler, onValue);
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::StringViewType JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_literal(CharType first) {
+			static constexpr CharType trueText[] = { static_cast<CharType>('t'), static_cast<CharType>('r'), static_cast<CharType>('u'), static_cast<CharType>('e') };
+			static constexpr CharType falseText[] = { static_cast<CharType>('f'), static_cast<CharType>('a'), static_cast<CharType>('l'), static_cast<CharType>('s'), static_cast<CharType>('e') };
+			static constexpr CharType nullText[] = { static_cast<CharType>('n'), static_cast<CharType>('u'), static_cast<CharType>('l'), static_cast<CharType>('l') };
+			switch (first) {
+			case static_cast<CharType>('t'):
+				return StringViewType(trueText, 4);
+			case static_cast<CharType>('f'):
+				return StringViewType(falseText, 5);
+			case static_cast<CharType>('n'):
+				return StringViewType(nullText, 4);
+			default:
+				return StringViewType();
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline bool JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_isCut(const CharType* first, const CharType* last) {
+			// Whether an unexpected token at the end of a chunk may be completed by the next chunk,
+			// so that its text is the same as when the lexer reads the whole input.
+			if (*first == static_cast<CharType>('\"'))
+				return true;
+			StringViewType literal = JsonPushParser::_literal(*first);
+			if (!literal.empty()) {
+				// The lexer reads as many characters as the literal has, up to the first mismatch.
+				const std::size_t size = static_cast<std::size_t>(last - first);
+				return size < literal.size() && literal.substr(0, size) == StringViewType(first, size);
+			}
+			// Numbers. Any other character is an unexpected token of its own.
+			switch (*first) {
+			case static_cast<CharType>('+'):
+			case static_cast<CharType>('-'):
+			case static_cast<CharType>('.'):
+				return true;
+			default:
+				return *first >= static_cast<CharType>('0') && *first <= static_cast<CharType>('9');
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline const typename JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::CharType* JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_continue(const CharType* first, const CharType* last, bool& complete) {
+			const CharType* curr = first;
+			StringViewType literal = JsonPushParser::_literal(this->_pending.front());
+			if (!literal.empty()) {
+				// A literal is read up to its length or the first mismatch, as the lexer does.
+				for (std::size_t size = this->_pending.size(); curr != last && size < literal.size(); ++size) {
+					if (*curr++ != literal[size]) {
+						complete = true;
+						return curr;
+					}
+				}
+				complete = (this->_pending.size() + static_cast<std::size_t>(curr - first) == literal.size());
+				return curr;
+			}
+			if (this->_pendingString) {
+				// A string ends at the first quote that is not escaped.
+				for (; curr != last; ++curr) {
+					if (this->_pendingEscape)
+						this->_pendingEscape = false;
+					else if (*curr == static_cast<CharType>('\\'))
+						this->_pendingEscape = true;
+					else if (*curr == static_cast<CharType>('\"'))
+						break;
+				}
+				complete = (curr != last);
+				return complete ? curr + 1 : last;
+			}
+			// Other tokens end before whitespace or punctuation.
+			for (; curr != last; ++curr) {
+				if (Lexer::_isWhitespace(*curr))
+					break;
+				switch (*curr) {
+				case static_cast<CharType>(','):
+				case static_cast<CharType>(':'):
+				case static_cast<CharType>('['):
+				case static_cast<CharType>(']'):
+				case static_cast<CharType>('{'):
+				case static_cast<CharType>('}'):
+				case static_cast<CharType>('\"'):
+					complete = true;
+					return curr;
+				default:
+					break;
+				}
+			}
+			complete = (curr != last);
+			return curr;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class HandlerTy, class F>
+		void JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_token(const Token& token, HandlerTy& handler, F& onValue) {
+			auto unexpected = [&](void) -> void {
+				if (token.type == JsonTokenType::Unexpected)
+					this->_error(token, "Unexpected characters \"", std::get<2>(token.data), "\".");
+			};
+			// Punctuation where a value is expected.
+			auto misplaced = [&](void) -> void {
+				CharType c = static_cast<CharType>(',');
+				switch (token.type) {
+				case JsonTokenType::Colon: c = static_cast<CharType>(':'); break;
+				case JsonTokenType::Rbracket: c = static_cast<CharType>(']'); break;
+				case JsonTokenType::Rbrace: c = static_cast<CharType>('}'); break;
+				default: break;
+				}
+				this->_error(token, "Unexpected characters \"", c, "\".");
+			};
+			auto endValue = [&](void) -> void {
+				if (this->_stack.empty()) {
+					this->_state = _State::Done;
+					onValue();
+				}
+				else {
+					this->_state = _State::CommaOrEnd;
+				}
+			};
+			auto close = [&](void) -> void {
+				if (this->_stack.back() == static_cast<CharType>('['))
+					handler.onEndArray();
+				else
+					handler.onEndObject();
+				this->_stack.pop_back();
+				endValue();
+			};
+			switch (this->_state) {
+			case _State::Done:
+				if (!this->_options.multipleValues)
+					this->_error(token, "Unexpected data after the value.");
+				[[fallthrough]];
+			case _State::ValueOrEnd:
+				if (this->_state == _State::ValueOrEnd && token.type == JsonTokenType::Rbracket) {
+					close();
+					return;
+				}
+				[[fallthrough]];
+			case _State::Value:
+				switch (token.type) {
+				case JsonTokenType::Null:
+					handler.onNull();
+					endValue();
+					return;
+				case JsonTokenType::Integer:
+					handler.onInteger(std::get<0>(token.data));
+					endValue();
+					return;
+				case JsonTokenType::Floating:
+					handler.onFloating(std::get<1>(token.data));
+					endValue();
+					return;
+				case JsonTokenType::String:
+					handler.onString(token.view());
+					endValue();
+					return;
+				case JsonTokenType::Bool:
+					handler.onBool(std::get<3>(token.data));
+					endValue();
+					return;
+				case JsonTokenType::Lbracket:
+					if (this->_stack.size() >= this->_options.maxDepth)
+						this->_error(token, "Maximum nesting depth exceeded.");
+					handler.onStartArray();
+					this->_stack.push_back(static_cast<CharType>('['));
+					this->_state = _State::ValueOrEnd;
+					return;
+				case JsonTokenType::Lbrace:
+					if (this->_stack.size() >= this->_options.maxDepth)
+						this->_error(token, "Maximum nesting depth exceeded.");
+					handler.onStartObject();
+					this->_stack.push_back(static_cast<CharType>('{'));
+					this->_state = _State::KeyOrEnd;
+					return;
+				default:
+					unexpected();
+					misplaced();
+					return;
+				}
+			case _State::KeyOrEnd:
+				if (token.type == JsonTokenType::Rbrace) {
+					close();
+					return;
+				}
+				[[fallthrough]];
+			case _State::Key:
+				unexpected();
+				if (token.type != JsonTokenType::String)
+					this->_error(token, "Object's key must be a string.");
+				handler.onKey(token.view());
+				this->_state = _State::Colon;
+				return;
+			case _State::Colon:
+				unexpected();
+				if (token.type != JsonTokenType::Colon)
+					this->_error(token, "Missing colon to separate key and value.");
+				this->_state = _State::Value;
+				return;
+			case _State::CommaOrEnd:
+			default:
+				unexpected();
+				if (this->_stack.back() == static_cast<CharType>('[')) {
+					if (token.type == JsonTokenType::Rbracket)
+						close();
+					else if (token.type == JsonTokenType::Comma)
+						this->_state = _State::Value;
+					else
+						this->_error(token, "Missing comma to separate elements in an array.");
+				}
+				else {
+					if (token.type == JsonTokenType::Rbrace)
+						close();
+					else if (token.type == JsonTokenType::Comma)
+						this->_state = _State::Key;
+					else
+						this->_error(token, "Missing comma to separate elements in an object.");
+				}
+				return;
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class... Args>
+		inline void JsonPushParser<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_error(Token token, Args&&... args) const {
+			this->_input->lexer._locate(token);
+			std::basic_stringstream<CharType> sstream;
+			sstream << "[Json Parser] ln:" << (token.line + 1U) << ", col:" << (token.col + 1U) << ", pos:" << (token.pos + 1U) << " ";
+			((sstream << std::forward<Args>(args)), ...);
+			throw std::runtime_error(InputAdapter::_toStdString(sstream.str()));
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonPushParser_hpp */
@@ -0,0 +1,408 @@
+/***********************************************************************
+ * @file	JsonSerializer.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements JsonSerializer class.
+***********************************************************************/
+#ifndef jjyou_io_JsonSerializer_hpp
+#define jjyou_io_JsonSerializer_hpp
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @struct	JsonDumpOptions
+		 * @brief	Options that control how Json is serialized.
+		 ***********************************************************************/
+		struct JsonDumpOptions {
+
+			/** @brief	Pretty or compact output.
+			  *
+			  * The pretty layout is the layout of `operator<<`: one array element or object
+			  * member per line, `" : "` between keys and values, and arrays/objects that are
+			  * values of an object member start on the next line. Compact output has no
+			  * whitespace at all.
+			  */
+			bool pretty = true;
+
+			/** @brief	Number of `indentChar` per indentation level in pretty output.
+			  */
+			std::size_t indent = 1;
+
+			/** @brief	Indentation character in pretty output.
+			  */
+			char indentChar = '\t';
+
+		};
+
+		/***********************************************************************
+		 * @class	JsonSerializer
+		 * @brief	Event-driven Json serializer that writes into a buffered sink.
+		 *
+		 * The member functions have the same names as the handler of `Json::sax`,
+		 * so a serializer can be passed to `Json::sax` to reformat a document
+		 * without building a Json container. `Json::dump`, `to_string` and
+		 * `operator<<` are implemented with it.
+		 *
+		 * Integers and floating points are formatted with `std::to_chars`. Floating
+		 * points use the shortest representation that round-trips, and always
+		 * contain a decimal point or an exponent so that they are read back as
+		 * floating points. Numbers kept as text (see `Json::ParseOptions::lazyNumbers`)
+		 * are written unchanged.
+		 *
+		 * Output is collected in a fixed-size buffer and passed to `sink` as
+		 * `sink(const CharType* data, std::size_t size)` when the buffer is full,
+		 * on `flush()`, and on destruction.
+		 *
+		 * @tparam	CharTy	The character type.
+		 * @tparam	SinkTy	The sink type.
+		 ***********************************************************************/
+		template <class CharTy, class SinkTy>
+		class JsonSerializer {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using CharType = CharTy;
+			using StringViewType = std::basic_string_view<CharType>;
+			static constexpr std::size_t bufferSize = 4096;
+			//@}
+
+			/** @brief	Construct a serializer.
+			  */
+			JsonSerializer(SinkTy sink, const JsonDumpOptions& options) : sink(std::forward<SinkTy>(sink)), options(options) {}
+
+			/** @brief	Copy constructor is disabled.
+			  */
+			JsonSerializer(const JsonSerializer&) = delete;
+
+			/** @brief	Destructor. Flush the buffer, ignoring exceptions thrown by the sink.
+			  */
+			~JsonSerializer(void) {
+				try {
+					this->flush();
+				}
+				catch (...) {}
+			}
+
+			/** @brief	Copy assignment is disabled.
+			  */
+			JsonSerializer& operator=(const JsonSerializer&) = delete;
+
+			/** @name	Events.
+			  */
+			//@{
+			void onNull(void);
+			template <class T>
+			void onInteger(T integer);
+			template <class T>
+			void onFloating(T floating);
+			template <class T>
+			void onBool(T boolean);
+			void onString(StringViewType string);
+			void onRawInteger(StringViewType text);
+			void onRawFloating(StringViewType text);
+			void onStartArray(void);
+			void onEndArray(void);
+			void onStartObject(void);
+			void onKey(StringViewType key);
+			void onEndObject(void);
+			//@}
+
+			/** @brief	Pass the buffered output to the sink.
+			  */
+			void flush(void);
+
+		private:
+
+			struct _Level {
+				bool object = false;
+				std::size_t indent = 0;
+				std::size_t count = 0;
+			};
+
+			SinkTy sink;
+			JsonDumpOptions options;
+			CharType buffer[bufferSize] = {};
+			std::size_t size = 0;
+			std::vector<_Level> levels{};
+
+			void _put(CharType c) {
+				if (this->size == bufferSize)
+					this->flush();
+				this->buffer[this->size++] = c;
+			}
+			void _write(const CharType* data, std::size_t length);
+			void _write(const char* data);
+			void _writeNarrow(const char* data, std::size_t length);
+			void _indent(std::size_t indent);
+			void _beginValue(bool container);
+			void _beginContainer(bool object, char bracket);
+			void _endContainer(char bracket);
+			void _escaped(StringViewType string);
+
+		};
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::flush(void) {
+			if (this->size != 0) {
+				std::size_t size = this->size;
+				this->size = 0;
+				this->sink(static_cast<const CharType*>(this->buffer), size);
+			}
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_write(const CharType* data, std::size_t length) {
+			if (this->size + length > bufferSize) {
+				this->flush();
+				if (length > bufferSize) {
+					this->sink(data, length);
+					return;
+				}
+			}
+			std::copy(data, data + length, this->buffer + this->size);
+			this->size += length;
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_write(const char* data) {
+			while (*data)
+				this->_put(static_cast<CharType>(*data++));
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_writeNarrow(const char* data, std::size_t length) {
+			if constexpr (std::is_same_v<CharType, char>) {
+				this->_write(data, length);
+			}
+			else {
+				for (std::size_t i = 0; i < length; ++i)
+					this->_put(static_cast<CharType>(data[i]));
+			}
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_indent(std::size_t indent) {
+			for (std::size_t i = indent * this->options.indent; i > 0; --i)
+				this->_put(static_cast<CharType>(this->options.indentChar));
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_beginValue(bool container) {
+			if (this->levels.empty())
+				return;
+			_Level& parent = this->levels.back();
+			if (parent.object) {
+				// The key has been written.
+				if (this->options.pretty && container) {
+					this->_put(static_cast<CharType>('\n'));
+					this->_indent(parent.indent + 2);
+				}
+				return;
+			}
+			if (parent.count++ != 0)
+				this->_put(static_cast<CharType>(','));
+			if (this->options.pretty) {
+				if (parent.count != 1)
+					this->_put(static_cast<CharType>('\n'));
+				this->_indent(parent.indent + 1);
+			}
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_beginContainer(bool object, char bracket) {
+			std::size_t indent = 0;
+			if (!this->levels.empty()) {
+				const _Level& parent = this->levels.back();
+				indent = parent.indent + (parent.object ? 2 : 1);
+			}
+			this->_beginValue(true);
+			this->_put(static_cast<CharType>(bracket));
+			if (this->options.pretty)
+				this->_put(static_cast<CharType>('\n'));
+			this->levels.push_back(_Level{ object, indent, 0 });
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_endContainer(char bracket) {
+			_Level level = this->levels.back();
+			this->levels.pop_back();
+			if (this->options.pretty) {
+				if (level.count != 0)
+					this->_put(static_cast<CharType>('\n'));
+				this->_indent(level.indent);
+			}
+			this->_put(static_cast<CharType>(bracket));
+			// Objects have always been followed by a line break in the pretty layout.
+			if (this->options.pretty && level.object)
+				this->_put(static_cast<CharType>('\n'));
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::_escaped(StringViewType string) {
+			this->_put(static_cast<CharType>('\"'));
+			const CharType* first = string.data();
+			const CharType* last = first + string.size();
+			const CharType* run = first;
+			for (const CharType* curr = first; curr != last; ++curr) {
+				char escape = 0;
+				switch (*curr) {
+				case static_cast<CharType>('\"'): escape = '\"'; break;
+				case static_cast<CharType>('\\'): escape = '\\'; break;
+				case static_cast<CharType>('/'): escape = '/'; break;
+				case static_cast<CharType>('\b'): escape = 'b'; break;
+				case static_cast<CharType>('\f'): escape = 'f'; break;
+				case static_cast<CharType>('\n'): escape = 'n'; break;
+				case static_cast<CharType>('\r'): escape = 'r'; break;
+				case static_cast<CharType>('\t'): escape = 't'; break;
+				default: break;
+				}
+				if (escape != 0) {
+					this->_write(run, static_cast<std::size_t>(curr - run));
+					this->_put(static_cast<CharType>('\\'));
+					this->_put(static_cast<CharType>(escape));
+					run = curr + 1;
+				}
+			}
+			this->_write(run, static_cast<std::size_t>(last - run));
+			this->_put(static_cast<CharType>('\"'));
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onNull(void) {
+			this->_beginValue(false);
+			this->_write("null");
+		}
+
+		template <class CharTy, class SinkTy> template <class T>
+		inline void JsonSerializer<CharTy, SinkTy>::onInteger(T integer) {
+			this->_beginValue(false);
+			if constexpr (std::is_integral_v<T>) {
+				char text[64];
+				std::to_chars_result res = std::to_chars(text, text + sizeof(text), integer);
+				this->_writeNarrow(text, static_cast<std::size_t>(res.ptr - text));
+			}
+			else {
+				std::ostringstream sstream;
+				sstream << integer;
+				const std::string text = sstream.str();
+				this->_writeNarrow(text.data(), text.size());
+			}
+		}
+
+		template <class CharTy, class SinkTy> template <class T>
+		inline void JsonSerializer<CharTy, SinkTy>::onFloating(T floating) {
+			this->_beginValue(false);
+			if constexpr (std::is_floating_point_v<T>) {
+				char text[64];
+				std::to_chars_result res = std::to_chars(text, text + sizeof(text), floating);
+				std::size_t length = static_cast<std::size_t>(res.ptr - text);
+				// Keep the type when reading it back, e.g. write 1.0 instead of 1.
+				if (std::find_if(text, res.ptr, [](char c) -> bool { return c == '.' || c == 'e' || c == 'n' || c == 'i'; }) == res.ptr) {
+					text[length++] = '.';
+					text[length++] = '0';
+				}
+				this->_writeNarrow(text, length);
+			}
+			else {
+				std::ostringstream sstream;
+				sstream << floating;
+				const std::string text = sstream.str();
+				this->_writeNarrow(text.data(), text.size());
+			}
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onRawInteger(StringViewType text) {
+			this->_beginValue(false);
+			this->_write(text.data(), text.size());
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onRawFloating(StringViewType text) {
+			this->_beginValue(false);
+			this->_write(text.data(), text.size());
+		}
+
+		template <class CharTy, class SinkTy> template <class T>
+		inline void JsonSerializer<CharTy, SinkTy>::onBool(T boolean) {
+			this->_beginValue(false);
+			this->_write(static_cast<bool>(boolean) ? "true" : "false");
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onString(StringViewType string) {
+			this->_beginValue(false);
+			this->_escaped(string);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onStartArray(void) {
+			this->_beginContainer(false, '[');
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onEndArray(void) {
+			this->_endContainer(']');
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onStartObject(void) {
+			this->_beginContainer(true, '{');
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onKey(StringViewType key) {
+			_Level& parent = this->levels.back();
+			if (parent.count++ != 0)
+				this->_put(static_cast<CharType>(','));
+			if (this->options.pretty) {
+				if (parent.count != 1)
+					this->_put(static_cast<CharType>('\n'));
+				this->_indent(parent.indent + 1);
+			}
+			this->_escaped(key);
+			this->_write(this->options.pretty ? " : " : ":");
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonSerializer<CharTy, SinkTy>::onEndObject(void) {
+			this->_endContainer('}');
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonSerializer_hpp */
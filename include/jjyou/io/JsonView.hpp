@@ -0,0 +1,645 @@
+/***********************************************************************
+ * @file	JsonView.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements JsonView class.
+***********************************************************************/
+#ifndef jjyou_io_JsonView_hpp
+#define jjyou_io_JsonView_hpp
+
+#include "Json.hpp"
+
+namespace jjyou {
+
+	namespace io {
+
+		/*============================================================
+		 *                    Forward declarations
+		 *============================================================*/
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> class JsonViewIterator;
+		/*============================================================
+		 *                 End of forward declarations
+		 *============================================================*/
+
+		/***********************************************************************
+		 * @class	JsonView
+		 * @brief	Lazy, read-only view of a json document stored in a buffer.
+		 *
+		 * Unlike `Json::parse`, no tree is built. A view only remembers where its
+		 * value starts in the buffer. Values are decoded when they are converted,
+		 * and subtrees that are not accessed are skipped without allocating.
+		 * Skipped subtrees are not validated, so malformed json is only reported
+		 * when the malformed part is reached.
+		 *
+		 * The view does not own the buffer. The buffer must stay alive and unchanged
+		 * as long as any view into it is used.
+		 *
+		 * Looking up an array element or an object member scans the container from
+		 * the beginning, so keep the returned views instead of indexing repeatedly.
+		 *
+		 * @tparam	IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy	Same as `Json`.
+		 ***********************************************************************/
+		template <
+			class IntegerTy = int,
+			class FloatingTy = float,
+			class StringTy = std::string,
+			class BoolTy = bool,
+			class ObjectPolicyTy = JsonMapObject
+		>
+		class JsonView {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using value_type = JsonView;
+			using size_type = std::size_t;
+			using iterator = JsonViewIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using const_iterator = iterator;
+			using IntegerType = IntegerTy;
+			using FloatingType = FloatingTy;
+			using StringType = StringTy;
+			using BoolType = BoolTy;
+			using CharType = StringType::value_type;
+			using StringViewType = std::basic_string_view<CharType>;
+			using DomType = Json<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			//@}
+
+			/** @brief	Default constructor. Create a view that refers to no buffer.
+			  *
+			  * It behaves as a null value: `type()` is `JsonType::Null`, `size()` is 0 and
+			  * it has no element.
+			  */
+			JsonView(void) = default;
+
+			/** @brief	Create a view of the json document stored in `document`.
+			  */
+			explicit JsonView(StringViewType document) :
+				_begin(document.data()),
+				_first(document.data()),
+				_end(document.data() + document.size())
+			{
+				this->_first = this->_skipWhitespace(this->_first);
+				if (this->_first == this->_end)
+					this->_error(this->_first, "Unexpected EOF.");
+			}
+
+			/** @brief	Create a view of the json document stored in `document`.
+			  */
+			explicit JsonView(const StringType& document) : JsonView(StringViewType(document.data(), document.size())) {}
+
+			/** @brief	Create a view of the json document stored in `document`.
+			  */
+			explicit JsonView(const CharType* document) : JsonView(StringViewType(document)) {}
+
+			/** @brief	Get the value type, judging from the first character of the value.
+			  */
+			JsonType type(void) const;
+
+			/** @brief	Check whether the value is null.
+			  */
+			bool isNull(void) const { return this->type() == JsonType::Null; }
+
+			/** @brief	Check whether the value is null.
+			  */
+			bool empty(void) const { return this->isNull(); }
+
+			/** @brief	Get the raw text of the value.
+			  */
+			StringViewType raw(void) const {
+				if (this->_first == nullptr)
+					return StringViewType();
+				return StringViewType(this->_first, static_cast<std::size_t>(this->_skipValue(this->_first) - this->_first));
+			}
+
+			/** @brief	Decode the value (and all its children) into a Json container.
+			  */
+			template <class JsonTy = DomType>
+			JsonTy toJson(void) const {
+				if (this->_first == nullptr)
+					return JsonTy();
+				return JsonTy::parse(this->raw());
+			}
+
+			/** @name	Conversion operators. They behave like the ones of `Json`.
+			  */
+			//@{
+			explicit operator IntegerType(void) const { return static_cast<IntegerType>(this->_scalar()); }
+			explicit operator FloatingType(void) const { return static_cast<FloatingType>(this->_scalar()); }
+			explicit operator StringType(void) const;
+			explicit operator BoolType(void) const { return static_cast<BoolType>(this->_scalar()); }
+			template <class T>
+			explicit operator std::vector<T>(void) const;
+			template <class T>
+			explicit operator std::map<StringType, T>(void) const;
+			//@}
+
+			/** @brief	Get the size of the value, with the same meaning as `Json::size()`.
+			  *
+			  * For arrays and objects the container is scanned.
+			  */
+			std::size_t size(void) const;
+
+			/** @brief	Get the element at a given position.
+			  *
+			  * The index starts from 0. This function is valid only if the value is an array.
+			  * Otherwise, or if the index is out of range, an exception of type std::out_of_range is thrown.
+			  */
+			JsonView operator[](size_type pos) const { return this->at(pos); }
+
+			/** @brief	Get the value that is mapped to the given key.
+			  *
+			  * This function is valid only if the value is an object that contains the key.
+			  * Otherwise, an exception of type std::out_of_range is thrown.
+			  */
+			JsonView operator[](StringViewType key) const { return this->at(key); }
+			JsonView operator[](const CharType* key) const { return this->at(StringViewType(key)); }
+			JsonView operator[](const StringType& key) const { return this->at(StringViewType(key.data(), key.size())); }
+
+			/** @brief	Same as `operator[](size_type)`.
+			  */
+			JsonView at(size_type pos) const;
+
+			/** @brief	Same as `operator[](StringViewType)`.
+			  */
+			JsonView at(StringViewType key) const;
+
+			/** @name	Iterator-related methods.
+			  * @brief	Get the iterator pointing to the specified position.
+			  */
+			//@{
+			const_iterator begin(void) const;
+			const_iterator cbegin(void) const { return this->begin(); }
+			const_iterator end(void) const;
+			const_iterator cend(void) const { return this->end(); }
+			//@}
+
+			/** @brief	Find the value that is mapped to the given key.
+			  *
+			  * This function is valid only if the value is an object.
+			  * Otherwise, an exception of type std::out_of_range is thrown.
+			  * @return	The iterator to the value that is mapped to the given key. If not found,
+			  *			an iterator pointing to the end of container will be returned.
+			  */
+			const_iterator find(StringViewType key) const;
+			const_iterator find(const CharType* key) const { return this->find(StringViewType(key)); }
+			const_iterator find(const StringType& key) const { return this->find(StringViewType(key.data(), key.size())); }
+
+		private:
+
+			using Lexer = JsonLexer<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			const CharType* _begin = nullptr;
+			const CharType* _first = nullptr;
+			const CharType* _end = nullptr;
+			JsonView(const CharType* begin, const CharType* first, const CharType* end) : _begin(begin), _first(first), _end(end) {}
+			DomType _scalar(void) const;
+			const CharType* _skipWhitespace(const CharType* curr) const {
+				while (curr != this->_end && Lexer::_isWhitespace(*curr))
+					++curr;
+				return curr;
+			}
+			const CharType* _skipString(const CharType* curr) const;
+			const CharType* _skipValue(const CharType* curr) const;
+			const CharType* _expect(const CharType* curr, CharType c) const;
+			[[noreturn]] void _error(const CharType* where, const char* message) const;
+			friend class JsonViewIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+
+		};
+
+		/***********************************************************************
+		 * @class	JsonViewIterator
+		 * @brief	Forward iterator type for JsonView class.
+		 *
+		 * Like `JsonIterator`, a null value has no element, a scalar value has
+		 * exactly one element which is itself, and arrays and objects iterate
+		 * over their elements and values.
+		 ***********************************************************************/
+		template <
+			class IntegerTy,
+			class FloatingTy,
+			class StringTy,
+			class BoolTy,
+			class ObjectPolicyTy
+		>
+		class JsonViewIterator {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = const value_type&;
+			using StringType = StringTy;
+			using CharType = StringType::value_type;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Default constructor.
+			  */
+			JsonViewIterator(void) = default;
+
+			/** @brief	Increment the iterator.
+			  * @return	Reference of the iterator after being incremented.
+			  */
+			JsonViewIterator& operator++(void);
+
+			/** @brief	Increment the iterator.
+			  * @return	Copy of the iterator before being incremented.
+			  */
+			JsonViewIterator operator++(int) {
+				JsonViewIterator ret = *this;
+				++(*this);
+				return ret;
+			}
+
+			/** @brief	Fetch the current element.
+			  */
+			reference operator*(void) const { return this->_value; }
+
+			/** @brief	Fetch the current element.
+			  */
+			pointer operator->(void) const { return &this->_value; }
+
+			/** @brief	Fetch the current element's key, decoded. This function is valid only if
+			  *			the value is an object. Otherwise, an exception of type std::out_of_range is thrown.
+			  */
+			StringType key(void) const;
+
+			/** @brief	Fetch the current element's key as it is written in the buffer,
+			  *			without quotes and without decoding escape sequences.
+			  */
+			StringViewType rawKey(void) const { return StringViewType(this->_key, this->_keyLength); }
+
+			/** @brief	Fetch the current element's value. Same as operator*.
+			  */
+			reference value(void) const { return this->_value; }
+
+			/** @brief	Compare two iterators of the same container.
+			  */
+			bool operator==(const JsonViewIterator& other) const { return this->_curr == other._curr; }
+
+		private:
+
+			using View = JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+			// A copy of the container, as the view that created the iterator may be a temporary.
+			View _parent{};
+			const CharType* _curr = nullptr;
+			const CharType* _key = nullptr;
+			std::size_t _keyLength = 0;
+			View _value{};
+			JsonViewIterator(const View& parent, const CharType* curr) : _parent(parent), _curr(curr) { this->_load(); }
+			void _load(void);
+			friend class JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>;
+
+		};
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonType JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::type(void) const {
+			if (this->_first == nullptr)
+				return JsonType::Null;
+			switch (*this->_first) {
+			case static_cast<CharType>('n'):
+				return JsonType::Null;
+			case static_cast<CharType>('t'):
+			case static_cast<CharType>('f'):
+				return JsonType::Bool;
+			case static_cast<CharType>('\"'):
+				return JsonType::String;
+			case static_cast<CharType>('['):
+				return JsonType::Array;
+			case static_cast<CharType>('{'):
+				return JsonType::Object;
+			case static_cast<CharType>('+'):
+			case static_cast<CharType>('-'):
+			case static_cast<CharType>('.'):
+			case static_cast<CharType>('0'):
+			case static_cast<CharType>('1'):
+			case static_cast<CharType>('2'):
+			case static_cast<CharType>('3'):
+			case static_cast<CharType>('4'):
+			case static_cast<CharType>('5'):
+			case static_cast<CharType>('6'):
+			case static_cast<CharType>('7'):
+			case static_cast<CharType>('8'):
+			case static_cast<CharType>('9'): {
+				const CharType* last = this->_skipValue(this->_first);
+				for (const CharType* curr = this->_first; curr != last; ++curr)
+					if (*curr == static_cast<CharType>('.') || *curr == static_cast<CharType>('e') || *curr == static_cast<CharType>('E'))
+						return JsonType::Floating;
+				return JsonType::Integer;
+			}
+			default:
+				this->_error(this->_first, "Unexpected characters.");
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator StringTy(void) const {
+			DomType json = this->_scalar();
+			if (json.type() != JsonType::String)
+				throw std::out_of_range("`JsonView::operator StringType() const` is valid only if the value is a string.");
+			return std::move(json.string());
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator std::vector<T>(void) const {
+			if (this->type() != JsonType::Array)
+				throw std::out_of_range("`JsonView::operator std::vector<T>() const` is valid only if the value is an array.");
+			std::vector<T> res;
+			for (const JsonView& v : *this)
+				res.emplace_back(v);
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy> template <class T>
+		inline JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator std::map<StringTy, T>(void) const {
+			if (this->type() != JsonType::Object)
+				throw std::out_of_range("`JsonView::operator std::map<StringType, T>() const` is valid only if the value is an object.");
+			std::map<StringType, T> res;
+			for (const_iterator iter = this->begin(); iter != this->end(); ++iter)
+				res.emplace(iter.key(), *iter);
+			return res;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline std::size_t JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::size(void) const {
+			switch (this->type()) {
+			case JsonType::Null:
+				return 0ULL;
+			case JsonType::Array:
+			case JsonType::Object:
+				return static_cast<std::size_t>(std::distance(this->begin(), this->end()));
+			default:
+				return 1ULL;
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::at(size_type pos) const {
+			if (this->type() != JsonType::Array)
+				throw std::out_of_range("`JsonView JsonView::at(size_type) const` is valid only if the value is an array.");
+			const_iterator iter = this->begin();
+			for (const const_iterator last = this->end(); iter != last && pos != 0; ++iter, --pos);
+			if (iter == this->end())
+				throw std::out_of_range("`JsonView JsonView::at(size_type) const`: index out of range.");
+			return *iter;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy> JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::at(StringViewType key) const {
+			const_iterator iter = this->find(key);
+			if (iter == this->end())
+				throw std::out_of_range("`JsonView JsonView::at(StringViewType) const`: key not found.");
+			return *iter;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::begin(void) const {
+			if (this->_first == nullptr)
+				return this->end();
+			switch (*this->_first) {
+			case static_cast<CharType>('n'):
+				return this->end();
+			case static_cast<CharType>('['):
+			case static_cast<CharType>('{'): {
+				const CharType* curr = this->_skipWhitespace(this->_first + 1);
+				if (curr == this->_end)
+					this->_error(curr, "Unexpected EOF.");
+				if (*curr == static_cast<CharType>(*this->_first == static_cast<CharType>('[') ? ']' : '}'))
+					return this->end();
+				return const_iterator(*this, curr);
+			}
+			default:
+				return const_iterator(*this, this->_first);
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::end(void) const {
+			const_iterator ret;
+			ret._parent = *this;
+			return ret;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::const_iterator JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::find(StringViewType key) const {
+			if (this->type() != JsonType::Object)
+				throw std::out_of_range("`JsonViewIterator JsonView::find(StringViewType) const` is valid only if the value is an object.");
+			const bool escaped = std::find(key.begin(), key.end(), static_cast<CharType>('\\')) != key.end();
+			for (const_iterator iter = this->begin(); iter != this->end(); ++iter) {
+				StringViewType rawKey = iter.rawKey();
+				// Keys without escape sequences can be compared in place.
+				if (std::find(rawKey.begin(), rawKey.end(), static_cast<CharType>('\\')) == rawKey.end()) {
+					if (!escaped && rawKey == key)
+						return iter;
+				}
+				else if (StringViewType(iter.key()) == key) {
+					return iter;
+				}
+			}
+			return this->end();
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline typename JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::DomType JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_scalar(void) const {
+			if (this->_first == nullptr)
+				return DomType();
+			switch (*this->_first) {
+			case static_cast<CharType>('['):
+			case static_cast<CharType>('{'):
+				throw std::out_of_range("JsonView: arrays and objects cannot be converted to scalars.");
+			default:
+				return DomType::parse(this->raw());
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline const typename JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::CharType* JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_skipString(const CharType* curr) const {
+			const CharType* first = curr++;
+			while (true) {
+				if constexpr (sizeof(CharType) == 1) {
+					curr = reinterpret_cast<const CharType*>(JsonStructuralIndex::_findQuoteOrBackslash(
+						reinterpret_cast<const char*>(curr),
+						reinterpret_cast<const char*>(this->_end)
+					));
+				}
+				else {
+					while (curr != this->_end && *curr != static_cast<CharType>('\"') && *curr != static_cast<CharType>('\\'))
+						++curr;
+				}
+				if (curr == this->_end)
+					this->_error(first, "Unterminated string.");
+				if (*curr == static_cast<CharType>('\"'))
+					return curr + 1;
+				curr += 2;
+				if (curr > this->_end)
+					this->_error(first, "Unterminated string.");
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline const typename JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::CharType* JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_skipValue(const CharType* curr) const {
+			switch (*curr) {
+			case static_cast<CharType>('\"'):
+				return this->_skipString(curr);
+			case static_cast<CharType>('['):
+			case static_cast<CharType>('{'): {
+				// Only brackets and strings matter when skipping a container.
+				const CharType* first = curr;
+				std::size_t depth = 0;
+				while (curr != this->_end) {
+					switch (*curr) {
+					case static_cast<CharType>('\"'):
+						curr = this->_skipString(curr);
+						continue;
+					case static_cast<CharType>('['):
+					case static_cast<CharType>('{'):
+						++depth;
+						break;
+					case static_cast<CharType>(']'):
+					case static_cast<CharType>('}'):
+						if (--depth == 0)
+							return curr + 1;
+						break;
+					default:
+						break;
+					}
+					++curr;
+				}
+				this->_error(first, "Unexpected EOF.");
+			}
+			default:
+				while (curr != this->_end && !Lexer::_isWhitespace(*curr)) {
+					switch (*curr) {
+					case static_cast<CharType>(','):
+					case static_cast<CharType>(':'):
+					case static_cast<CharType>(']'):
+					case static_cast<CharType>('}'):
+						return curr;
+					default:
+						++curr;
+					}
+				}
+				return curr;
+			}
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline const typename JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::CharType* JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_expect(const CharType* curr, CharType c) const {
+			curr = this->_skipWhitespace(curr);
+			if (curr == this->_end)
+				this->_error(curr, "Unexpected EOF.");
+			if (*curr != c) {
+				switch (c) {
+				case static_cast<CharType>(':'):
+					this->_error(curr, "Missing colon to separate key and value.");
+				case static_cast<CharType>('\"'):
+					this->_error(curr, "Object's key must be a string.");
+				default:
+					this->_error(curr, "Unexpected characters.");
+				}
+			}
+			return curr;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void JsonView<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_error(const CharType* where, const char* message) const {
+			std::size_t line = 0, col = 0;
+			for (const CharType* curr = this->_begin; curr != where; ++curr) {
+				if (*curr == static_cast<CharType>('\n')) {
+					++line;
+					col = 0;
+				}
+				else {
+					++col;
+				}
+			}
+			std::stringstream sstream;
+			sstream << "[Json View] ln:" << (line + 1U) << ", col:" << (col + 1U) << ", pos:" << (where - this->_begin + 1) << " " << message;
+			throw std::runtime_error(sstream.str());
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline JsonViewIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>& JsonViewIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::operator++(void) {
+			const View& parent = this->_parent;
+			switch (*parent._first) {
+			case static_cast<CharType>('['):
+			case static_cast<CharType>('{'): {
+				const CharType closing = static_cast<CharType>(*parent._first == static_cast<CharType>('[') ? ']' : '}');
+				const CharType* curr = parent._skipWhitespace(parent._skipValue(this->_value._first));
+				if (curr == parent._end)
+					parent._error(curr, "Unexpected EOF.");
+				if (*curr == closing) {
+					this->_curr = nullptr;
+				}
+				else if (*curr == static_cast<CharType>(',')) {
+					this->_curr = parent._skipWhitespace(curr + 1);
+					if (this->_curr == parent._end)
+						parent._error(this->_curr, "Unexpected EOF.");
+					this->_load();
+				}
+				else {
+					parent._error(curr, closing == static_cast<CharType>(']') ? "Missing comma to separate elements in an array." : "Missing comma to separate elements in an object.");
+				}
+				break;
+			}
+			default:
+				this->_curr = nullptr;
+				break;
+			}
+			return *this;
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline StringTy JsonViewIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::key(void) const {
+			if (*this->_parent._first != static_cast<CharType>('{'))
+				throw std::out_of_range("`StringType JsonViewIterator::key() const` is valid only if the value is an object.");
+			return StringType(View(this->_parent._begin, this->_key - 1, this->_parent._end));
+		}
+
+		template <class IntegerTy, class FloatingTy, class StringTy, class BoolTy, class ObjectPolicyTy>
+		inline void JsonViewIterator<IntegerTy, FloatingTy, StringTy, BoolTy, ObjectPolicyTy>::_load(void) {
+			const View& parent = this->_parent;
+			const CharType* value = this->_curr;
+			if (*parent._first == static_cast<CharType>('{')) {
+				const CharType* key = parent._expect(this->_curr, static_cast<CharType>('\"'));
+				const CharType* keyEnd = parent._skipString(key);
+				this->_key = key + 1;
+				this->_keyLength = static_cast<std::size_t>(keyEnd - key - 2);
+				value = parent._skipWhitespace(parent._expect(keyEnd, static_cast<CharType>(':')) + 1);
+				if (value == parent._end)
+					parent._error(value, "Unexpected EOF.");
+			}
+			if (*parent._first == static_cast<CharType>('[') || *parent._first == static_cast<CharType>('{'))
+				this->_value = View(parent._begin, value, parent._end);
+			else
+				this->_value = parent;
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonView_hpp */
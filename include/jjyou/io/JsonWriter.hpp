@@ -0,0 +1,360 @@
+/***********************************************************************
+ * @file	JsonWriter.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements JsonWriter class and its sinks.
+***********************************************************************/
+#ifndef jjyou_io_JsonWriter_hpp
+#define jjyou_io_JsonWriter_hpp
+
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "JsonSerializer.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JJYOU_IO_JSON_WRITER_POSIX
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @class	JsonStringSink
+		 * @brief	Sink of `JsonWriter` that appends the output to a string.
+		 ***********************************************************************/
+		template <class StringTy>
+		class JsonStringSink {
+
+		public:
+
+			using CharType = typename StringTy::value_type;
+
+			/** @brief	Construct a sink that appends to `string`, which must outlive it.
+			  */
+			explicit JsonStringSink(StringTy& string) : string(&string) {}
+
+			/** @brief	Append the output.
+			  */
+			void operator()(const CharType* data, std::size_t size) {
+				this->string->append(data, size);
+			}
+
+		private:
+
+			StringTy* string;
+
+		};
+
+		/***********************************************************************
+		 * @class	JsonStreamSink
+		 * @brief	Sink of `JsonWriter` that writes the output to an output stream.
+		 ***********************************************************************/
+		template <class CharTy>
+		class JsonStreamSink {
+
+		public:
+
+			using CharType = CharTy;
+
+			/** @brief	Construct a sink that writes to `out`, which must outlive it.
+			  */
+			explicit JsonStreamSink(std::basic_ostream<CharTy>& out) : out(&out) {}
+
+			/** @brief	Write the output. An exception of type std::runtime_error is
+			  *			thrown if the stream fails.
+			  */
+			void operator()(const CharTy* data, std::size_t size) {
+				if (!this->out->write(data, static_cast<std::streamsize>(size)))
+					throw std::runtime_error("[Json Writer] Failed to write to the output stream.");
+			}
+
+		private:
+
+			std::basic_ostream<CharTy>* out;
+
+		};
+
+#ifdef JJYOU_IO_JSON_WRITER_POSIX
+		/***********************************************************************
+		 * @class	JsonFileSink
+		 * @brief	Sink of `JsonWriter` that writes the output to a POSIX file descriptor.
+		 *
+		 * The file descriptor is not closed by the sink. Output is written with
+		 * `::write`, without another level of buffering.
+		 ***********************************************************************/
+		class JsonFileSink {
+
+		public:
+
+			using CharType = char;
+
+			/** @brief	Construct a sink that writes to the file descriptor `fd`.
+			  */
+			explicit JsonFileSink(int fd) : fd(fd) {}
+
+			/** @brief	Write the output. An exception of type std::runtime_error is
+			  *			thrown if the file descriptor cannot be written.
+			  */
+			void operator()(const char* data, std::size_t size) {
+				while (size != 0) {
+					::ssize_t written = ::write(this->fd, data, size);
+					if (written < 0) {
+						if (errno == EINTR)
+							continue;
+						throw std::runtime_error("[Json Writer] Failed to write to the file descriptor.");
+					}
+					data += written;
+					size -= static_cast<std::size_t>(written);
+				}
+			}
+
+		private:
+
+			int fd;
+
+		};
+#endif
+
+		/***********************************************************************
+		 * @class	JsonWriter
+		 * @brief	Write a json document directly into a buffered sink, without
+		 *			building a Json container.
+		 *
+		 * Values are written in document order:
+		 * @code
+		 * std::string out;
+		 * JsonWriter writer{ JsonStringSink(out), JsonDumpOptions{ false } };
+		 * writer.beginObject();
+		 * writer.key("frame"); writer.value(42);
+		 * writer.key("pose"); writer.beginArray(); writer.value(0.5); writer.value(1.0); writer.endArray();
+		 * writer.endObject();
+		 * writer.flush();
+		 * @endcode
+		 *
+		 * The output is formatted by `JsonSerializer`, so it is byte-identical to `Json::dump`
+		 * and `to_string` for the same content and options. E.g. `value(1.5f)` is written like
+		 * a Json whose `FloatingType` is `float`, and `value(1.5)` like a Json of `double`.
+		 * The writer holds a fixed-size buffer and one entry per open container, so its
+		 * memory does not depend on the size of the output. The buffer is passed to the
+		 * sink when it is full, on `flush()`, and on destruction (see `JsonSerializer`).
+		 *
+		 * The calls must form one valid json value: `key` only directly inside an object,
+		 * one value after each key, and each `end...` matching the innermost open container.
+		 * This is checked with `assert` in debug builds only.
+		 *
+		 * The writer also has the events of `JsonSerializer`, so it can be passed as the
+		 * handler of `Json::emit`, `Json::sax` or `JsonBinder::emit`, e.g. to write a Json
+		 * container, a parsed input or a struct as one value of the document.
+		 *
+		 * @tparam	CharTy	The character type.
+		 * @tparam	SinkTy	The sink type, called as `sink(const CharTy* data, std::size_t size)`,
+		 *					e.g. `JsonStringSink`, `JsonStreamSink`, `JsonFileSink` or a reference
+		 *					to a callable. `CharTy` is deduced from the sinks of this file.
+		 ***********************************************************************/
+		template <class CharTy, class SinkTy>
+		class JsonWriter {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using CharType = CharTy;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Construct a writer.
+			  */
+			explicit JsonWriter(SinkTy sink, const JsonDumpOptions& options = JsonDumpOptions()) : serializer(std::forward<SinkTy>(sink), options) {}
+
+			/** @brief	Copy constructor is disabled.
+			  */
+			JsonWriter(const JsonWriter&) = delete;
+
+			/** @brief	Copy assignment is disabled.
+			  */
+			JsonWriter& operator=(const JsonWriter&) = delete;
+
+			/** @name	Containers.
+			  * @brief	Open or close an array or an object.
+			  */
+			//@{
+			void beginArray(void);
+			void endArray(void);
+			void beginObject(void);
+			void endObject(void);
+			//@}
+
+			/** @brief	Write the key of the next member of the innermost object.
+			  */
+			void key(StringViewType key);
+
+			/** @name	Values.
+			  * @brief	Write a value: null, a bool, an integer, a floating point or a string.
+			  */
+			//@{
+			void value(std::nullptr_t);
+			template <class T> requires std::is_arithmetic_v<T>
+			void value(T number);
+			void value(StringViewType string);
+			void value(const CharType* string) { this->value(StringViewType(string)); }
+			//@}
+
+			/** @name	Events.
+			  * @brief	The events of `JsonSerializer`, with the same checks as the functions above.
+			  */
+			//@{
+			void onNull(void) { this->value(nullptr); }
+			template <class T>
+			void onInteger(T integer) { this->_beginValue(); this->serializer.onInteger(integer); }
+			template <class T>
+			void onFloating(T floating) { this->_beginValue(); this->serializer.onFloating(floating); }
+			template <class T>
+			void onBool(T boolean) { this->_beginValue(); this->serializer.onBool(boolean); }
+			void onString(StringViewType string) { this->value(string); }
+			void onRawInteger(StringViewType text) { this->_beginValue(); this->serializer.onRawInteger(text); }
+			void onRawFloating(StringViewType text) { this->_beginValue(); this->serializer.onRawFloating(text); }
+			void onStartArray(void) { this->beginArray(); }
+			void onEndArray(void) { this->endArray(); }
+			void onStartObject(void) { this->beginObject(); }
+			void onKey(StringViewType key) { this->key(key); }
+			void onEndObject(void) { this->endObject(); }
+			//@}
+
+			/** @brief	Pass the buffered output to the sink.
+			  */
+			void flush(void) { this->serializer.flush(); }
+
+		private:
+
+			JsonSerializer<CharType, SinkTy> serializer;
+#ifndef NDEBUG
+			// Whether each open container is an object, innermost last.
+			std::vector<bool> objects{};
+			bool hasKey = false;
+			bool hasRoot = false;
+#endif
+			void _beginValue(void);
+
+		};
+
+		template <class SinkTy>
+		JsonWriter(SinkTy, const JsonDumpOptions&) -> JsonWriter<typename SinkTy::CharType, SinkTy>;
+		template <class SinkTy>
+		JsonWriter(SinkTy) -> JsonWriter<typename SinkTy::CharType, SinkTy>;
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::_beginValue(void) {
+#ifndef NDEBUG
+			if (this->objects.empty()) {
+				assert(!this->hasRoot && "JsonWriter: a document has only one root value.");
+				this->hasRoot = true;
+			}
+			else if (this->objects.back()) {
+				assert(this->hasKey && "JsonWriter: a value in an object must follow a key.");
+				this->hasKey = false;
+			}
+#endif
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::beginArray(void) {
+			this->_beginValue();
+#ifndef NDEBUG
+			this->objects.push_back(false);
+#endif
+			this->serializer.onStartArray();
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::endArray(void) {
+#ifndef NDEBUG
+			assert(!this->objects.empty() && !this->objects.back() && "JsonWriter: endArray does not close an array.");
+			this->objects.pop_back();
+#endif
+			this->serializer.onEndArray();
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::beginObject(void) {
+			this->_beginValue();
+#ifndef NDEBUG
+			this->objects.push_back(true);
+#endif
+			this->serializer.onStartObject();
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::endObject(void) {
+#ifndef NDEBUG
+			assert(!this->objects.empty() && this->objects.back() && "JsonWriter: endObject does not close an object.");
+			assert(!this->hasKey && "JsonWriter: the last key of the object has no value.");
+			this->objects.pop_back();
+#endif
+			this->serializer.onEndObject();
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::key(StringViewType key) {
+#ifndef NDEBUG
+			assert(!this->objects.empty() && this->objects.back() && "JsonWriter: a key must be written directly inside an object.");
+			assert(!this->hasKey && "JsonWriter: the previous key has no value.");
+			this->hasKey = true;
+#endif
+			this->serializer.onKey(key);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::value(std::nullptr_t) {
+			this->_beginValue();
+			this->serializer.onNull();
+		}
+
+		template <class CharTy, class SinkTy> template <class T> requires std::is_arithmetic_v<T>
+		inline void JsonWriter<CharTy, SinkTy>::value(T number) {
+			this->_beginValue();
+			if constexpr (std::is_same_v<T, bool>)
+				this->serializer.onBool(number);
+			else if constexpr (std::is_integral_v<T>)
+				this->serializer.onInteger(number);
+			else
+				this->serializer.onFloating(number);
+		}
+
+		template <class CharTy, class SinkTy>
+		inline void JsonWriter<CharTy, SinkTy>::value(StringViewType string) {
+			this->_beginValue();
+			this->serializer.onString(string);
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_JsonWriter_hpp */
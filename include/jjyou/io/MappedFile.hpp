@@ -0,0 +1,163 @@
+/***********************************************************************
+ * @file	MappedFile.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements MappedFile class.
+***********************************************************************/
+#ifndef jjyou_io_MappedFile_hpp
+#define jjyou_io_MappedFile_hpp
+
+#include <cstddef>
+#include <filesystem>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JJYOU_IO_MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @enum	MappedFileHint
+		 * @brief	Expected access pattern of a mapped file, passed to the kernel
+		 *			as a paging hint.
+		 ***********************************************************************/
+		enum class MappedFileHint {
+			Normal,
+			Sequential,
+			Random
+		};
+
+		/***********************************************************************
+		 * @class	MappedFile
+		 * @brief	Read-only memory mapping of a regular file.
+		 *
+		 * The file is mapped as a whole. Mapping is only attempted for non-empty
+		 * regular files on POSIX systems. For pipes, character devices and other
+		 * special files, for files reporting a zero size (which includes procfs
+		 * and sysfs entries), or on platforms without `mmap`, `isMapped()` returns
+		 * `false` and the caller is expected to fall back to buffered reads.
+		 * The class is movable but not copyable.
+		 ***********************************************************************/
+		class MappedFile {
+
+		public:
+
+			/** @brief	Construct an empty mapping.
+			  */
+			MappedFile(void) = default;
+
+			/** @brief	Map a file read-only.
+			  *
+			  * No exception is thrown if the file cannot be mapped. Check `isMapped()` instead.
+			  */
+			explicit MappedFile(const std::filesystem::path& path, MappedFileHint hint = MappedFileHint::Sequential) {
+#ifdef JJYOU_IO_MAPPED_FILE_POSIX
+				int fd = ::open(path.c_str(), O_RDONLY);
+				if (fd < 0)
+					return;
+				struct stat info {};
+				// A zero size is not trusted: procfs and sysfs files report it but have
+				// content, so they are left unmapped for the buffered fallback.
+				if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+					void* addr = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+					if (addr != MAP_FAILED) {
+						this->_data = static_cast<const char*>(addr);
+						this->_size = static_cast<std::size_t>(info.st_size);
+						this->_mapped = true;
+						switch (hint) {
+						case MappedFileHint::Sequential:
+							::madvise(addr, this->_size, MADV_SEQUENTIAL);
+							break;
+						case MappedFileHint::Random:
+							::madvise(addr, this->_size, MADV_RANDOM);
+							break;
+						default:
+							break;
+						}
+					}
+				}
+				::close(fd);
+#else
+				(void)path;
+				(void)hint;
+#endif
+			}
+
+			/** @brief	Copy constructor is disabled.
+			  */
+			MappedFile(const MappedFile&) = delete;
+
+			/** @brief	Move constructor.
+			  */
+			MappedFile(MappedFile&& other) noexcept :
+				_data(std::exchange(other._data, nullptr)),
+				_size(std::exchange(other._size, 0)),
+				_mapped(std::exchange(other._mapped, false))
+			{}
+
+			/** @brief	Destructor. Unmap the file.
+			  */
+			~MappedFile(void) {
+				this->_unmap();
+			}
+
+			/** @brief	Copy assignment is disabled.
+			  */
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			/** @brief	Move assignment.
+			  */
+			MappedFile& operator=(MappedFile&& other) noexcept {
+				if (this != &other) {
+					this->_unmap();
+					this->_data = std::exchange(other._data, nullptr);
+					this->_size = std::exchange(other._size, 0);
+					this->_mapped = std::exchange(other._mapped, false);
+				}
+				return *this;
+			}
+
+			/** @brief	Check whether the file has been mapped.
+			  * @return	`true` if the whole file is accessible through `data()`.
+			  *			Files reporting a zero size are never mapped.
+			  */
+			bool isMapped(void) const { return this->_mapped; }
+
+			/** @brief	Get the first byte of the mapping.
+			  */
+			const char* data(void) const { return this->_data; }
+
+			/** @brief	Get the size of the mapping in bytes.
+			  */
+			std::size_t size(void) const { return this->_size; }
+
+		private:
+
+			const char* _data = nullptr;
+			std::size_t _size = 0;
+			bool _mapped = false;
+
+			void _unmap(void) {
+#ifdef JJYOU_IO_MAPPED_FILE_POSIX
+				if (this->_data)
+					::munmap(const_cast<char*>(this->_data), this->_size);
+#endif
+				this->_data = nullptr;
+				this->_size = 0;
+				this->_mapped = false;
+			}
+
+		};
+
+	}
+
+}
+
+#endif /* jjyou_io_MappedFile_hpp */
@@ -0,0 +1,373 @@
+/***********************************************************************
+ * @file	NdjsonReader.hpp
+ * @author	jjyou
+ * @date	2026-10-16
+ * @brief	This file implements NdjsonReader class.
+***********************************************************************/
+#ifndef jjyou_io_NdjsonReader_hpp
+#define jjyou_io_NdjsonReader_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include "Json.hpp"
+#include "MappedFile.hpp"
+
+namespace jjyou {
+
+	namespace io {
+
+		/***********************************************************************
+		 * @class	NdjsonReader
+		 * @brief	Parallel reader of newline-delimited json (NDJSON / JSON Lines).
+		 *
+		 * The input is split into chunks of whole lines, which are parsed on a
+		 * pool of threads. Every non-blank line is parsed as one Json record.
+		 * A record that fails to parse carries the error message of the parser
+		 * instead of aborting the whole input.
+		 *
+		 * Files are memory-mapped (see `MappedFile`). Other buffers are not copied
+		 * and must stay alive as long as the reader is used.
+		 *
+		 * @tparam	JsonTy	The Json type of the records. Default is `Json<>`.
+		 ***********************************************************************/
+		template <class JsonTy = Json<>>
+		class NdjsonReader {
+
+		public:
+
+			/** @name	Type definitions and inline constants.
+			  */
+			//@{
+			using DomType = JsonTy;
+			using CharType = typename DomType::CharType;
+			using StringViewType = std::basic_string_view<CharType>;
+			//@}
+
+			/** @brief	Options that control how the input is read.
+			  */
+			struct Options {
+
+				/** @brief	Number of worker threads. 0 means `std::thread::hardware_concurrency()`.
+				  */
+				std::size_t threads = 0;
+
+				/** @brief	Approximate number of characters per chunk. A chunk is the unit of work
+				  *			of a thread, and always ends at a line break.
+				  */
+				std::size_t chunkSize = 1 << 18;
+
+				/** @brief	Options passed to `Json::parse` for each record.
+				  */
+				typename DomType::ParseOptions parseOptions{};
+
+			};
+
+			/** @brief	A parsed line.
+			  */
+			struct Record {
+
+				/** @brief	Line number in the input, starting from 1.
+				  */
+				std::size_t line = 0;
+
+				/** @brief	The parsed record. Null if parsing failed.
+				  */
+				DomType json{};
+
+				/** @brief	The error message if parsing failed, otherwise empty.
+				  */
+				std::string error{};
+
+				/** @brief	Check whether the record was parsed successfully.
+				  */
+				bool good(void) const { return this->error.empty(); }
+
+			};
+
+			/** @brief	Open a file with default options.
+			  */
+			explicit NdjsonReader(const std::filesystem::path& path);
+
+			/** @brief	Open a file.
+			  *
+			  * Non-empty regular files are memory-mapped. Other files, such as pipes and
+			  * zero-size procfs entries, are read into memory.
+			  * An exception of type std::runtime_error is thrown if the file cannot be opened.
+			  */
+			NdjsonReader(const std::filesystem::path& path, const Options& options);
+
+			/** @brief	Read from a caller-owned buffer with default options.
+			  */
+			explicit NdjsonReader(StringViewType buffer);
+
+			/** @brief	Read from a caller-owned buffer.
+			  */
+			NdjsonReader(StringViewType buffer, const Options& options);
+
+			/** @brief	Parse all records and pass them to `callback` in input order.
+			  *
+			  * `callback` is called as `callback(Record&&)` on the calling thread. Workers
+			  * parse at most a few chunks ahead of the record being delivered, so memory
+			  * usage does not grow with the input size.
+			  * Exceptions thrown by `callback` or by the workers (e.g. std::bad_alloc) stop
+			  * the workers and are rethrown, after the records of the previous chunks.
+			  */
+			template <class F>
+			void read(F&& callback) const;
+
+			/** @brief	Parse all records and pass them to `callback` as soon as they are parsed.
+			  *
+			  * `callback` is called as `callback(Record&&)` concurrently from the worker
+			  * threads, so it must be thread-safe. Records of the same chunk are delivered
+			  * in order, records of different chunks in no particular order.
+			  * Exceptions thrown by `callback` stop the workers and are rethrown.
+			  */
+			template <class F>
+			void readUnordered(F&& callback) const;
+
+			/** @brief	Parse all records and return them in input order.
+			  */
+			std::vector<Record> readAll(void) const;
+
+		private:
+
+			struct _Chunk {
+				const CharType* first = nullptr;
+				const CharType* last = nullptr;
+				std::size_t line = 0;
+			};
+
+			Options _options{};
+			std::shared_ptr<const void> _owner{};
+			std::vector<_Chunk> _chunks{};
+
+			void _split(const CharType* first, const CharType* last);
+
+			std::size_t _threads(void) const;
+
+			template <class F>
+			void _parse(const _Chunk& chunk, F&& callback) const;
+
+		};
+
+	}
+
+}
+
+
+
+/*======================================================================
+ | Implementation
+ ======================================================================*/
+/// @cond
+
+namespace jjyou {
+
+	namespace io {
+
+		template <class JsonTy>
+		inline NdjsonReader<JsonTy>::NdjsonReader(const std::filesystem::path& path) : NdjsonReader(path, Options()) {}
+
+		template <class JsonTy>
+		inline NdjsonReader<JsonTy>::NdjsonReader(const std::filesystem::path& path, const Options& options) : _options(options) {
+			if constexpr (sizeof(CharType) == 1) {
+				auto file = std::make_shared<const MappedFile>(path, MappedFileHint::Sequential);
+				if (file->isMapped()) {
+					const CharType* first = reinterpret_cast<const CharType*>(file->data());
+					this->_owner = file;
+					this->_split(first, first + file->size());
+					return;
+				}
+			}
+			std::basic_ifstream<CharType> fin(path, std::ios::in | std::ios::binary);
+			if (!fin.is_open())
+				throw std::runtime_error("Cannot open input ndjson file \"" + path.string() + "\".");
+			std::basic_ostringstream<CharType> sstream;
+			sstream << fin.rdbuf();
+			auto buffer = std::make_shared<const std::basic_string<CharType>>(std::move(sstream).str());
+			this->_owner = buffer;
+			this->_split(buffer->data(), buffer->data() + buffer->size());
+		}
+
+		template <class JsonTy>
+		inline NdjsonReader<JsonTy>::NdjsonReader(StringViewType buffer) : NdjsonReader(buffer, Options()) {}
+
+		template <class JsonTy>
+		inline NdjsonReader<JsonTy>::NdjsonReader(StringViewType buffer, const Options& options) : _options(options) {
+			this->_split(buffer.data(), buffer.data() + buffer.size());
+		}
+
+		template <class JsonTy>
+		inline void NdjsonReader<JsonTy>::_split(const CharType* first, const CharType* last) {
+			const std::size_t chunkSize = std::max<std::size_t>(this->_options.chunkSize, 1);
+			std::size_t line = 0;
+			while (first != last) {
+				const CharType* end = (static_cast<std::size_t>(last - first) > chunkSize) ? first + chunkSize : last;
+				end = std::find(end, last, static_cast<CharType>('\n'));
+				if (end != last)
+					++end;
+				this->_chunks.push_back(_Chunk{ first, end, line });
+				line += static_cast<std::size_t>(std::count(first, end, static_cast<CharType>('\n')));
+				first = end;
+			}
+		}
+
+		template <class JsonTy>
+		inline std::size_t NdjsonReader<JsonTy>::_threads(void) const {
+			std::size_t threads = this->_options.threads;
+			if (threads == 0)
+				threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+			return std::min(threads, std::max<std::size_t>(this->_chunks.size(), 1));
+		}
+
+		template <class JsonTy> template <class F>
+		inline void NdjsonReader<JsonTy>::_parse(const _Chunk& chunk, F&& callback) const {
+			std::size_t line = chunk.line;
+			for (const CharType* first = chunk.first; first != chunk.last; ++line) {
+				const CharType* last = std::find(first, chunk.last, static_cast<CharType>('\n'));
+				bool blank = std::all_of(first, last, [](CharType c) -> bool {
+					return c == static_cast<CharType>(' ') || c == static_cast<CharType>('\t') || c == static_cast<CharType>('\r');
+				});
+				if (!blank) {
+					Record record;
+					record.line = line + 1;
+					try {
+						record.json = DomType::parse(StringViewType(first, static_cast<std::size_t>(last - first)), this->_options.parseOptions);
+					}
+					catch (const std::exception& e) {
+						record.error = e.what();
+					}
+					callback(std::move(record));
+				}
+				first = (last == chunk.last) ? last : last + 1;
+			}
+		}
+
+		template <class JsonTy> template <class F>
+		inline void NdjsonReader<JsonTy>::read(F&& callback) const {
+			const std::size_t numChunks = this->_chunks.size();
+			const std::size_t numThreads = this->_threads();
+			// Workers may run this many chunks ahead of the chunk being delivered.
+			const std::size_t window = numThreads * 2;
+			std::mutex mutex;
+			std::condition_variable cv;
+			std::size_t next = 0;
+			std::size_t delivered = 0;
+			bool stop = false;
+			std::exception_ptr exception{};
+			std::vector<std::vector<Record>> results(numChunks);
+			std::vector<char> ready(numChunks, 0);
+			std::vector<std::jthread> workers;
+			auto work = [&](void) -> void {
+				while (true) {
+					std::size_t index = 0;
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+						cv.wait(lock, [&]() -> bool { return stop || next == numChunks || next < delivered + window; });
+						if (stop || next == numChunks)
+							return;
+						index = next++;
+					}
+					try {
+						std::vector<Record> records;
+						this->_parse(this->_chunks[index], [&](Record&& record) -> void { records.push_back(std::move(record)); });
+						std::lock_guard<std::mutex> lock(mutex);
+						results[index] = std::move(records);
+						ready[index] = 1;
+					}
+					catch (...) {
+						// E.g. out of memory. The delivering thread rethrows it.
+						std::lock_guard<std::mutex> lock(mutex);
+						if (!exception)
+							exception = std::current_exception();
+						stop = true;
+					}
+					cv.notify_all();
+				}
+			};
+			try {
+				workers.reserve(numThreads);
+				for (std::size_t i = 0; i < numThreads; ++i)
+					workers.emplace_back(work);
+				for (std::size_t i = 0; i < numChunks; ++i) {
+					std::vector<Record> records;
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+						cv.wait(lock, [&]() -> bool { return ready[i] != 0 || exception; });
+						if (ready[i] == 0)
+							std::rethrow_exception(exception);
+						records = std::move(results[i]);
+						++delivered;
+					}
+					cv.notify_all();
+					for (Record& record : records)
+						callback(std::move(record));
+				}
+			}
+			catch (...) {
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					stop = true;
+				}
+				cv.notify_all();
+				throw;
+			}
+		}
+
+		template <class JsonTy> template <class F>
+		inline void NdjsonReader<JsonTy>::readUnordered(F&& callback) const {
+			const std::size_t numChunks = this->_chunks.size();
+			const std::size_t numThreads = this->_threads();
+			std::atomic<std::size_t> next = 0;
+			std::atomic<bool> stop = false;
+			std::mutex mutex;
+			std::exception_ptr exception{};
+			auto work = [&](void) -> void {
+				for (std::size_t index = next++; index < numChunks && !stop; index = next++) {
+					try {
+						this->_parse(this->_chunks[index], callback);
+					}
+					catch (...) {
+						std::lock_guard<std::mutex> lock(mutex);
+						if (!exception)
+							exception = std::current_exception();
+						stop = true;
+					}
+				}
+			};
+			{
+				std::vector<std::jthread> workers;
+				workers.reserve(numThreads);
+				for (std::size_t i = 0; i < numThreads; ++i)
+					workers.emplace_back(work);
+			}
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+
+		template <class JsonTy>
+		inline std::vector<typename NdjsonReader<JsonTy>::Record> NdjsonReader<JsonTy>::readAll(void) const {
+			std::vector<Record> res;
+			this->read([&](Record&& record) -> void { res.push_back(std::move(record)); });
+			return res;
+		}
+
+	}
+
+}
+
+/// @endcond
+
+#endif /* jjyou_io_NdjsonReader_hpp */